@@ -16,7 +16,15 @@
  */
 
 #include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <lydia/dfa/batch.hpp>
+#include <lydia/dfa/binary_format.hpp>
+#include <lydia/dfa/compiled_dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <lydia/dfa/mona_file.hpp>
 #include <lydia/logic/ldlf/base.hpp>
+#include <lydia/monitor/batch.hpp>
 #include <lydia/to_dfa/core.hpp>
 #include <lydia/utils/benchmark.hpp>
 #include <random>
@@ -44,4 +52,198 @@ static void BM_dfa_instantiation(benchmark::State &state) {
 }
 BENCHMARK(BM_dfa_instantiation);
 
+/*
+ * Write a MONA DFA file with the structure of
+ * lib/test/src/assets/mona/eventually_a.dfa, scaled up to N states:
+ * a counter that moves to the next state when 'a' is true.
+ */
+static std::string write_counter_mona_file(int N) {
+  auto path = std::filesystem::temp_directory_path() /
+              ("lydia-bench-counter-" + std::to_string(N) + ".dfa");
+  std::ofstream out(path);
+  out << "MONA DFA\n"
+      << "number of variables: 1\n"
+      << "variables: a\n"
+      << "orders: 2\n"
+      << "states: " << N << "\n"
+      << "initial: 0\n"
+      << "bdd nodes: " << 2 * N << "\n"
+      << "final:";
+  for (int i = 0; i < N; i++)
+    out << (i == N - 1 ? " 1" : " -1");
+  out << "\nbehaviour:";
+  for (int i = 0; i < N; i++)
+    out << " " << N + i;
+  out << "\nbdd:\n";
+  for (int i = 0; i < N; i++)
+    out << " -1 " << i << " 0\n";
+  for (int i = 0; i < N; i++)
+    out << " 0 " << i << " " << std::min(i + 1, N - 1) << "\n";
+  out << "end\n";
+  return path.string();
+}
+
+static void BM_parse_mona_file(benchmark::State &state) {
+  auto filename = write_counter_mona_file(state.range(0));
+  for (auto _ : state) {
+    auto file = parse_mona_dfa_file(filename);
+    escape(&file);
+  }
+  std::filesystem::remove(filename);
+}
+// clang-format off
+BENCHMARK(BM_parse_mona_file)
+  ->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000)
+  ->Unit(benchmark::kMillisecond);
+// clang-format on
+
+static void BM_read_mona_file(benchmark::State &state) {
+  auto filename = write_counter_mona_file(state.range(0));
+  for (auto _ : state) {
+    auto mgr = CUDD::Cudd();
+    auto my_dfa = dfa::read_from_file(filename, mgr);
+    escape(&my_dfa);
+  }
+  std::filesystem::remove(filename);
+}
+// clang-format off
+BENCHMARK(BM_read_mona_file)
+  ->Arg(1000)->Arg(10000)->Arg(100000)
+  ->Unit(benchmark::kMillisecond);
+// clang-format on
+
+static void BM_parse_binary_file(benchmark::State &state) {
+  auto filename = write_counter_mona_file(state.range(0));
+  auto binary_filename = filename + ".bin";
+  {
+    std::ofstream out(binary_filename, std::ios::binary);
+    write_binary_dfa(out, parse_mona_dfa_file(filename));
+  }
+  for (auto _ : state) {
+    auto file = parse_binary_dfa_file(binary_filename);
+    escape(&file);
+  }
+  std::filesystem::remove(filename);
+  std::filesystem::remove(binary_filename);
+}
+// clang-format off
+BENCHMARK(BM_parse_binary_file)
+  ->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000)
+  ->Unit(benchmark::kMillisecond);
+// clang-format on
+
+/*
+ * Random traces over one variable, each of the given length.
+ */
+static std::vector<trace> random_traces(int nb_traces, int length) {
+  std::mt19937 generator(42);
+  std::bernoulli_distribution coin(0.1);
+  std::vector<trace> result(nb_traces);
+  for (auto &word : result)
+    for (int k = 0; k < length; k++)
+      word.push_back({coin(generator)});
+  return result;
+}
+
+static void BM_accepts_sequential(benchmark::State &state) {
+  auto filename = write_counter_mona_file(100);
+  auto automaton =
+      mona_dfa(mona_dfa_from_file(parse_mona_dfa_file(filename)), 1);
+  auto words = random_traces(state.range(0), 100);
+  for (auto _ : state) {
+    size_t nb_accepted = 0;
+    for (const auto &word : words)
+      nb_accepted += automaton.accepts(word);
+    escape(&nb_accepted);
+  }
+  state.SetItemsProcessed(state.iterations() * words.size());
+  std::filesystem::remove(filename);
+}
+// clang-format off
+BENCHMARK(BM_accepts_sequential)
+  ->Arg(10000)->Arg(100000)
+  ->Unit(benchmark::kMillisecond);
+// clang-format on
+
+static void BM_accepts_many(benchmark::State &state) {
+  auto filename = write_counter_mona_file(100);
+  auto automaton =
+      mona_dfa(mona_dfa_from_file(parse_mona_dfa_file(filename)), 1);
+  auto buffer = TraceBuffer(1);
+  for (const auto &word : random_traces(state.range(0), 100))
+    buffer.add_trace(word);
+  auto pool = ThreadPool(state.range(1));
+  for (auto _ : state) {
+    auto verdicts = accepts_many(automaton, buffer, &pool);
+    escape(&verdicts);
+  }
+  state.SetItemsProcessed(state.iterations() * buffer.get_nb_traces());
+  std::filesystem::remove(filename);
+}
+// clang-format off
+BENCHMARK(BM_accepts_many)
+  ->Args({10000, 1})->Args({100000, 1})
+  ->Args({100000, 2})->Args({100000, 4})->Args({100000, 8})
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+// clang-format on
+
+static void BM_accepts_compiled(benchmark::State &state) {
+  auto filename = write_counter_mona_file(100);
+  auto automaton =
+      mona_dfa(mona_dfa_from_file(parse_mona_dfa_file(filename)), 1);
+  auto compiled = compiled_dfa(automaton);
+  std::vector<std::vector<uint32_t>> words;
+  for (const auto &word : random_traces(state.range(0), 100)) {
+    words.emplace_back();
+    for (const auto &symbol : word)
+      words.back().push_back(compiled_dfa::encode(symbol));
+  }
+  for (auto _ : state) {
+    size_t nb_accepted = 0;
+    for (const auto &word : words)
+      nb_accepted += compiled.accepts(word);
+    escape(&nb_accepted);
+  }
+  state.SetItemsProcessed(state.iterations() * words.size());
+  std::filesystem::remove(filename);
+}
+// clang-format off
+BENCHMARK(BM_accepts_compiled)
+  ->Arg(10000)->Arg(100000)
+  ->Unit(benchmark::kMillisecond);
+// clang-format on
+
+static void BM_step_instances_virtual(benchmark::State &state) {
+  auto filename = write_counter_mona_file(100);
+  auto automaton =
+      mona_dfa(mona_dfa_from_file(parse_mona_dfa_file(filename)), 1);
+  auto compiled = compiled_dfa(automaton);
+  const abstract_dfa &dfa = compiled;
+  std::vector<int> states(state.range(0), dfa.get_initial_state());
+  std::vector<interpretation> symbols(states.size(), interpretation{1});
+  for (auto _ : state) {
+    for (size_t i = 0; i < states.size(); i++)
+      states[i] = dfa.get_successor(states[i], symbols[i]);
+    escape(states.data());
+  }
+  state.SetItemsProcessed(state.iterations() * states.size());
+  std::filesystem::remove(filename);
+}
+BENCHMARK(BM_step_instances_virtual)->Arg(1024)->Arg(65536);
+
+static void BM_step_instances_batch(benchmark::State &state) {
+  auto filename = write_counter_mona_file(100);
+  auto automaton =
+      mona_dfa(mona_dfa_from_file(parse_mona_dfa_file(filename)), 1);
+  auto batch = MonitorBatch(compiled_dfa(automaton), state.range(0));
+  std::vector<uint32_t> symbols(batch.size(), 1);
+  for (auto _ : state) {
+    batch.step(symbols);
+    escape(&batch);
+  }
+  state.SetItemsProcessed(state.iterations() * batch.size());
+  std::filesystem::remove(filename);
+}
+BENCHMARK(BM_step_instances_batch)->Arg(1024)->Arg(65536);
+
 } // namespace whitemech::lydia::Benchmark
@@ -0,0 +1,121 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <benchmark/benchmark.h>
+#include <lydia/mona_ext/mona_ext_base.hpp>
+#include <lydia/utils/benchmark.hpp>
+
+namespace whitemech::lydia::Benchmark {
+
+typedef DFA* (*concatenate_fn)(DFA*, DFA*, int, int*);
+typedef DFA* (*closure_fn)(DFA*, int, int*);
+
+// Sequence a_0 ; a_1 ; ... ; a_{N-1}, concatenated from the right.
+// With stars, every a_i is replaced by a_i*, built with the closure.
+template <concatenate_fn concatenate, closure_fn closure>
+inline DFA* concatenate_chain(int N, std::vector<int> &indices,
+                              bool with_stars) {
+  DFA* result = dfaLDLfTrue();
+  for (int i = N - 1; i >= 0; --i) {
+    DFA* atom = dfaNext(i);
+    DFA* tmp = dfa_accept_empty(atom);
+    DFA* current = tmp;
+    if (with_stars) {
+      current = closure(tmp, N, indices.data());
+      dfaFree(tmp);
+    }
+    tmp = concatenate(current, result, N, indices.data());
+    dfaFree(atom);
+    dfaFree(current);
+    dfaFree(result);
+    result = tmp;
+  }
+  return result;
+}
+
+template <concatenate_fn concatenate, closure_fn closure>
+static void BM_concatenate_chain(benchmark::State &state) {
+  auto N = state.range(0);
+  auto indices = std::vector<int>(N);
+  std::iota(indices.begin(), indices.end(), 0);
+  for (auto _ : state) {
+    DFA* result = concatenate_chain<concatenate, closure>(N, indices, false);
+    escape(result);
+    dfaFree(result);
+  }
+}
+// clang-format off
+BENCHMARK_TEMPLATE(BM_concatenate_chain, dfa_concatenate, dfa_closure)
+  ->Arg(5)->Arg(10)->Arg(20)->Arg(40)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_concatenate_chain, dfa_concatenate_with_guards,
+                   dfa_closure_with_guards)
+  ->Arg(5)->Arg(10)->Arg(20)->Arg(40)
+  ->Unit(benchmark::kMillisecond);
+// clang-format on
+
+template <concatenate_fn concatenate, closure_fn closure>
+static void BM_concatenate_chain_of_stars(benchmark::State &state) {
+  auto N = state.range(0);
+  auto indices = std::vector<int>(N);
+  std::iota(indices.begin(), indices.end(), 0);
+  for (auto _ : state) {
+    DFA* result = concatenate_chain<concatenate, closure>(N, indices, true);
+    escape(result);
+    dfaFree(result);
+  }
+}
+// clang-format off
+BENCHMARK_TEMPLATE(BM_concatenate_chain_of_stars, dfa_concatenate,
+                   dfa_closure)
+  ->Arg(5)->Arg(10)->Arg(20)->Arg(40)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_concatenate_chain_of_stars, dfa_concatenate_with_guards,
+                   dfa_closure_with_guards)
+  ->Arg(5)->Arg(10)->Arg(20)->Arg(40)
+  ->Unit(benchmark::kMillisecond);
+// clang-format on
+
+// (a_0 ; ... ; a_{N-1})*, closed repeatedly.
+template <closure_fn closure>
+static void BM_nested_closure(benchmark::State &state) {
+  auto N = state.range(0);
+  auto indices = std::vector<int>(N);
+  std::iota(indices.begin(), indices.end(), 0);
+  DFA* chain =
+      concatenate_chain<dfa_concatenate, dfa_closure>(N, indices, false);
+  for (auto _ : state) {
+    DFA* result = dfaCopy(chain);
+    for (int i = 0; i < N; i++) {
+      DFA* tmp = closure(result, N, indices.data());
+      dfaFree(result);
+      result = tmp;
+    }
+    escape(result);
+    dfaFree(result);
+  }
+  dfaFree(chain);
+}
+// clang-format off
+BENCHMARK_TEMPLATE(BM_nested_closure, dfa_closure)
+  ->Arg(5)->Arg(10)->Arg(20)->Arg(40)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_nested_closure, dfa_closure_with_guards)
+  ->Arg(5)->Arg(10)->Arg(20)->Arg(40)
+  ->Unit(benchmark::kMillisecond);
+// clang-format on
+
+} // namespace whitemech::lydia::Benchmark
@@ -107,7 +107,7 @@ inline void translate_sequence_of_atoms(int N, Strategy &s) {
 static void BM_translate_sequence_of_atoms_bdd(benchmark::State &state) {
   for (auto _ : state) {
     auto mgr = CUDD::Cudd();
-    auto s = BDDStrategy(mgr, 20);
+    auto s = BDDStrategy(mgr);
     auto N = state.range(0);
     translate_sequence_of_atoms(N, s);
   }
@@ -158,7 +158,7 @@ BM_translate_sequence_of_stars_of_atoms_bdd(benchmark::State &state) {
   for (auto _ : state) {
     auto mgr =
         CUDD::Cudd(0, 0, BENCH_CUDD_UNIQUE_SLOTS, BENCH_CUDD_CACHE_SLOTS, 0);
-    auto s = BDDStrategy(mgr, 20);
+    auto s = BDDStrategy(mgr);
     auto N = state.range(0);
     translate_sequence_of_stars_of_atoms(N, s);
   }
@@ -211,7 +211,7 @@ static void BM_translate_union_bdd(benchmark::State &state) {
   for (auto _ : state) {
     auto mgr =
         CUDD::Cudd(0, 0, BENCH_CUDD_UNIQUE_SLOTS, BENCH_CUDD_CACHE_SLOTS, 0);
-    auto s = BDDStrategy(mgr, 20);
+    auto s = BDDStrategy(mgr);
     auto N = state.range(0);
     translate_union(N, s);
   }
@@ -244,4 +244,39 @@ BENCHMARK(BM_translate_union_compositional)
     ->DisplayAggregatesOnly(true);
 // clang-format on
 
+// Conjunction of N instances of the response pattern
+inline void translate_responses(int N, Strategy &s) {
+  std::string formula_string;
+  for (int i = 0; i < N; i++) {
+    auto index = std::to_string(i);
+    if (i > 0)
+      formula_string += " & ";
+    formula_string +=
+        "[true*]([req_" + index + "]ff | <true*><grant_" + index + ">tt)";
+  }
+  auto sstream = std::stringstream(formula_string);
+  auto driver = parsers::ldlf::Driver();
+  driver.parse(sstream);
+  auto formula = driver.result;
+  auto translator = Translator(s);
+  auto automaton = translator.to_dfa(*formula);
+  escape(&automaton);
+  (void)automaton;
+}
+
+static void BM_translate_responses_compositional(benchmark::State &state) {
+  for (auto _ : state) {
+    auto s = CompositionalStrategy();
+    s.use_templates = state.range(1);
+    translate_responses(state.range(0), s);
+  }
+}
+// clang-format off
+BENCHMARK(BM_translate_responses_compositional)
+    ->Args({4, 0})->Args({4, 1})
+    ->Args({8, 0})->Args({8, 1})
+    ->Args({12, 0})->Args({12, 1})
+    ->Unit(benchmark::kMillisecond);
+// clang-format on
+
 } // namespace whitemech::lydia::Benchmark
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <lydia/dfa/interpretation_bits.hpp>
 #include <lydia/logger.hpp>
 #include <lydia/types.hpp>
 #include <set>
@@ -37,16 +38,32 @@ public:
    * Check whether a word of propositional interpretations
    * is accepted by the DFA.
    *
-   * //TODO consider using bit vectors for an interpretation.
-   *
    * @return true if the word is accepted, false otherwise.
    */
   virtual bool accepts(const trace& word) const = 0;
 
+  /*!
+   * The same as the above, but the word is made of bitsets.
+   */
+  virtual bool accepts(const trace_bits& word) const {
+    int current_state = get_initial_state();
+    for (const auto& symbol : word)
+      current_state = get_successor(current_state, symbol);
+    return is_final(current_state);
+  }
+
   virtual int get_successor(int state, const interpretation& symbol) const = 0;
   virtual int get_successor(int state,
                             const interpretation_set& symbol) const = 0;
 
+  /*!
+   * Compute the successor of a state, without allocating memory
+   * (if the number of variables is small, see interpretation_bits).
+   * The variables beyond the size of the symbol are false.
+   */
+  virtual int get_successor(int state,
+                            const interpretation_bits& symbol) const = 0;
+
   virtual bool is_final(int state) const = 0;
 
   /*!
@@ -0,0 +1,124 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <lydia/dfa/abstract_dfa.hpp>
+#include <lydia/dfa/classification.hpp>
+#include <lydia/types.hpp>
+#include <lydia/utils/thread_pool.hpp>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * A set of traces, stored in a flat buffer.
+ *
+ * Every interpretation takes get_words_per_symbol() 64-bit words, where
+ * the bit i is the truth value of the variable i. The interpretations of
+ * all the traces are stored one after the other, and the trace t is made
+ * of the interpretations in [get_trace_begin(t), get_trace_end(t)).
+ */
+class TraceBuffer {
+private:
+  int nb_variables_;
+  size_t words_per_symbol_;
+  std::vector<uint64_t> data_;
+  std::vector<size_t> offsets_;
+
+public:
+  explicit TraceBuffer(int nb_variables);
+
+  /*!
+   * Wrap an existing buffer.
+   *
+   * @param nb_variables the number of variables.
+   * @param data the bit-packed interpretations.
+   * @param offsets the index of the first interpretation of every trace,
+   *      | followed by the total number of interpretations.
+   * @throw std::invalid_argument if the offsets are not consistent
+   *      | with the data.
+   */
+  TraceBuffer(int nb_variables, std::vector<uint64_t> data,
+              std::vector<size_t> offsets);
+
+  void add_trace(const trace& word);
+  void add_trace(const trace_bits& word);
+  void clear();
+
+  int get_nb_variables() const { return nb_variables_; }
+  size_t get_words_per_symbol() const { return words_per_symbol_; }
+  size_t get_nb_traces() const { return offsets_.size() - 1; }
+  size_t get_nb_symbols() const { return offsets_.back(); }
+  size_t get_trace_begin(size_t t) const { return offsets_[t]; }
+  size_t get_trace_end(size_t t) const { return offsets_[t + 1]; }
+
+  const uint64_t* get_symbol(size_t symbol) const {
+    return data_.data() + symbol * words_per_symbol_;
+  }
+  bool get_value(size_t symbol, int variable) const {
+    return (get_symbol(symbol)[variable >> 6] >> (variable & 63)) & 1;
+  }
+};
+
+/*!
+ * A vector of booleans, 64 per word.
+ */
+class VerdictBitmap {
+private:
+  std::vector<uint64_t> words_;
+  size_t size_;
+
+public:
+  explicit VerdictBitmap(size_t size)
+      : words_((size + 63) / 64, 0), size_{size} {}
+
+  bool operator[](size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1; }
+  void set(size_t i) { words_[i >> 6] |= uint64_t(1) << (i & 63); }
+  void unset(size_t i) { words_[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+  void set_word(size_t w, uint64_t value) { words_[w] = value; }
+  size_t size() const { return size_; }
+  size_t count() const;
+  const std::vector<uint64_t>& get_words() const { return words_; }
+};
+
+/*!
+ * Check which traces are accepted by the DFA.
+ *
+ * For a MONA DFA, the BDDs are walked directly on the bit-packed
+ * interpretations; for a compiled DFA, the packed interpretation is the
+ * index in the table; for a compressed DFA, it is classified first. In
+ * these cases, the traces are split among the threads of the pool, if
+ * given. The other DFAs go through get_successor
+ * in the calling thread, since it is not thread safe for the CUDD DFA
+ * (the reference counts of the BDD nodes are updated).
+ *
+ * @param automaton the DFA.
+ * @param traces the traces. They must have at least as many variables
+ *      | as the DFA.
+ * @param pool the thread pool, or nullptr.
+ * @param classification if not nullptr, a trace is not read further
+ *      | once a sink of the DFA is reached (see classify_states).
+ * @return the bitmap of the accepted traces.
+ * @throw std::invalid_argument if the traces have too few variables.
+ */
+VerdictBitmap
+accepts_many(const abstract_dfa& automaton, const TraceBuffer& traces,
+             ThreadPool* pool = nullptr,
+             const StateClassification* classification = nullptr);
+
+} // namespace whitemech::lydia
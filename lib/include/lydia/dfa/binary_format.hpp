@@ -0,0 +1,160 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <lydia/dfa/mona_file.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <mona/dfa.h>
+}
+
+namespace whitemech::lydia {
+
+class dfa;
+class mona_dfa;
+
+/*!
+ * Binary serialization of DFAs.
+ *
+ * All the integers are 32 bits, little-endian. The layout is:
+ *
+ *   "LYDIADFA"                      magic (8 bytes)
+ *   version                         BINARY_DFA_VERSION
+ *   nb_variables
+ *   { length, bytes }*              the names of the variables
+ *   { x, l, r }*                    the BDD nodes, as in MonaDFAFile
+ *   { -2, 0, 0 }                    end of the node table
+ *   nb_states, initial_state
+ *   { node }*                       the root node of each state
+ *   bitmap                          finality, ceil(nb_states / 8) bytes
+ *
+ * The index x of an internal node is the position of the variable.
+ * The successors of a node always precede it, so the node table can
+ * be loaded in one pass; this also lets the writer emit the nodes as
+ * soon as they are visited, without knowing their number in advance.
+ */
+const std::uint32_t BINARY_DFA_VERSION = 1;
+
+/*!
+ * Streaming writer of the binary format.
+ *
+ * The sections must be written in order: header, nodes, states.
+ */
+class BinaryDFAWriter {
+private:
+  std::ostream& out_;
+  int nb_nodes_ = 0;
+  bool nodes_closed_ = false;
+
+  void write_int(std::int32_t value);
+
+public:
+  explicit BinaryDFAWriter(std::ostream& out) : out_{out} {}
+
+  void write_header(const std::vector<std::string>& variables);
+
+  /*!
+   * Write a leaf.
+   *
+   * @param value the state of the leaf.
+   * @return the identifier of the node.
+   */
+  int write_leaf(int value);
+
+  /*!
+   * Write an internal node. Its successors must have been written.
+   *
+   * @param position the position of the variable.
+   * @param low the identifier of the low successor.
+   * @param high the identifier of the high successor.
+   * @return the identifier of the node.
+   */
+  int write_node(int position, int low, int high);
+
+  /*!
+   * Close the node table and write the states.
+   *
+   * @param initial_state the initial state.
+   * @param roots the identifier of the root node of each state.
+   * @param finals the finality of each state.
+   * @throw std::runtime_error if the stream is in a failed state.
+   */
+  void write_states(int initial_state, const std::vector<int>& roots,
+                    const std::vector<bool>& finals);
+};
+
+void write_binary_dfa(std::ostream& out, const MonaDFAFile& content);
+
+/*!
+ * Write a MONA DFA. Only the nodes reachable from the states are written.
+ */
+void write_binary_dfa(std::ostream& out, const mona_dfa& automaton);
+
+/*!
+ * Write a symbolic DFA.
+ *
+ * The transition function of each state is turned back into a shared
+ * multi-terminal BDD, by cofactoring the roots with respect to the
+ * variables, in order of position.
+ */
+void write_binary_dfa(std::ostream& out, const dfa& automaton);
+
+/*!
+ * Same as write_binary_dfa, on a file.
+ *
+ * @throw std::runtime_error if the file cannot be written.
+ */
+void write_binary_dfa_file(const std::string& filename,
+                           const mona_dfa& automaton);
+void write_binary_dfa_file(const std::string& filename,
+                           const dfa& automaton);
+
+/*!
+ * Parse a binary DFA file.
+ *
+ * The file is memory-mapped, and the content is returned in the same
+ * form of a parsed MONA DFA file, so it can be given to the dfa
+ * constructor or to mona_dfa_from_file.
+ *
+ * @param filename path to the binary DFA file.
+ * @return the content of the file.
+ * @throw std::runtime_error if the file cannot be read, is malformed,
+ *      | or has an unsupported version.
+ */
+MonaDFAFile parse_binary_dfa_file(const std::string& filename);
+
+/*!
+ * Same as parse_binary_dfa_file, on a buffer already in memory.
+ */
+MonaDFAFile parse_binary_dfa(const char* begin, const char* end);
+
+/*!
+ * Build a MONA DFA from the content of a DFA file.
+ *
+ * The nodes may be in any order, so also the content of a MONA DFA
+ * file is accepted. The variable at position i is mapped to the MONA index i.
+ *
+ * @param file the content of the file.
+ * @return the MONA DFA. The caller owns it.
+ */
+DFA* mona_dfa_from_file(const MonaDFAFile& file);
+
+} // namespace whitemech::lydia
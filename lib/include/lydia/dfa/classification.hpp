@@ -0,0 +1,103 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <lydia/dfa/abstract_dfa.hpp>
+#include <lydia/dfa/dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * The class of a DFA state, with respect to the verdicts that can
+ * still be reached from it.
+ *
+ * From an accepting (resp. rejecting) sink, only final (resp. non-final)
+ * states are reachable, so the verdict cannot change anymore. Note that
+ * a sink need not be a single state with a self-loop.
+ */
+enum class StateClass : uint8_t { live, accepting_sink, rejecting_sink };
+
+/*!
+ * The class of every state of a DFA, one byte per state.
+ */
+class StateClassification {
+private:
+  std::vector<StateClass> classes_;
+
+public:
+  StateClassification() = default;
+  explicit StateClassification(std::vector<StateClass> classes)
+      : classes_{std::move(classes)} {}
+
+  StateClass get_class(int state) const { return classes_[state]; }
+  bool is_live(int state) const {
+    return classes_[state] == StateClass::live;
+  }
+  bool is_accepting_sink(int state) const {
+    return classes_[state] == StateClass::accepting_sink;
+  }
+  bool is_rejecting_sink(int state) const {
+    return classes_[state] == StateClass::rejecting_sink;
+  }
+  int get_nb_states() const { return classes_.size(); }
+};
+
+/*!
+ * Classify the states, given the successors of every state.
+ *
+ * The states that can reach a final (resp. non-final) state are
+ * found with a backward reachability from the final (resp. non-final)
+ * states.
+ *
+ * @param successors the successors of every state, in any order and
+ *      | possibly with duplicates.
+ * @param finals whether every state is final.
+ * @return the classification.
+ */
+StateClassification
+classify_states(const std::vector<std::vector<int>>& successors,
+                const std::vector<bool>& finals);
+
+/*!
+ * Classify the states of a MONA DFA. The successors of a state are the
+ * leaves of its transition BDD.
+ */
+StateClassification classify_states(const mona_dfa& automaton);
+
+/*!
+ * Classify the states of a CUDD DFA. The successors of a state are
+ * found by cofactoring the transition BDDs with the state bits, and
+ * then with the variables, until every bit is constant.
+ */
+StateClassification classify_states(const dfa& automaton);
+
+/*!
+ * Check whether a word is accepted, stopping as soon as a sink
+ * is reached.
+ *
+ * @param automaton the DFA.
+ * @param classification the classification of the states of the DFA.
+ * @param word the word.
+ * @return true if the word is accepted, false otherwise.
+ */
+bool accepts(const abstract_dfa& automaton,
+             const StateClassification& classification, const trace& word);
+
+} // namespace whitemech::lydia
@@ -0,0 +1,124 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <lydia/dfa/abstract_dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * A read-only DFA with an explicit transition table.
+ *
+ * An interpretation is encoded as an integer, whose bit i is the truth
+ * value of the variable i, and the successor of a state is stored for
+ * every interpretation, in a dense table of 2^k entries per state.
+ * The entries are 16-bit wide if there are at most 2^16 states, and
+ * 32-bit wide otherwise. Hence, a step is a single indexed load, but
+ * the number of variables k must be small.
+ */
+class compiled_dfa : public abstract_dfa {
+public:
+  static const int MAX_NB_VARIABLES = 16;
+
+private:
+  int nb_variables_;
+  int nb_states_;
+  int initial_state_;
+  std::vector<bool> finals_;
+  std::vector<uint16_t> table16_;
+  std::vector<uint32_t> table32_;
+
+  /*!
+   * The encoded interpretations have bits only below nb_variables_.
+   */
+  uint32_t mask_() const { return (uint32_t(1) << nb_variables_) - 1; }
+  void allocate_();
+  void set_successor_(int state, uint32_t symbol, int successor);
+  void fill_mona_(const mona_dfa& automaton, unsigned node, int state,
+                  uint32_t symbol, int position);
+
+public:
+  /*!
+   * Build the table of a DFA. For a MONA DFA, the BDD of every state is
+   * visited once; otherwise, get_successor is called on every state and
+   * interpretation.
+   *
+   * @throw std::invalid_argument if there are more than MAX_NB_VARIABLES
+   *      | variables.
+   */
+  explicit compiled_dfa(const abstract_dfa& automaton);
+
+  static uint32_t encode(const interpretation& symbol);
+  static uint32_t encode(const interpretation_set& symbol);
+  uint32_t encode(const interpretation_bits& symbol) const {
+    return symbol.data()[0] & mask_();
+  }
+
+  int get_initial_state() const override { return initial_state_; }
+  int get_nb_states() const override { return nb_states_; }
+  int get_nb_variables() const override { return nb_variables_; }
+
+  /*!
+   * The successor of a state, for an encoded interpretation.
+   * The bits beyond the number of variables must be zero.
+   */
+  int get_successor(int state, uint32_t symbol) const {
+    size_t i = ((size_t)state << nb_variables_) | symbol;
+    return table16_.empty() ? (int)table32_[i] : (int)table16_[i];
+  }
+  int get_successor(int state, const interpretation& symbol) const override {
+    return get_successor(state, encode(symbol) & mask_());
+  }
+  int get_successor(int state,
+                    const interpretation_set& symbol) const override {
+    return get_successor(state, encode(symbol) & mask_());
+  }
+  int get_successor(int state,
+                    const interpretation_bits& symbol) const override {
+    return get_successor(state, encode(symbol));
+  }
+
+  bool is_final(int state) const override { return finals_[state]; }
+
+  using abstract_dfa::accepts;
+  bool accepts(const trace& word) const override;
+  bool accepts(const std::vector<uint32_t>& word) const;
+
+  /*!
+   * The size of the transition table, in bytes.
+   */
+  size_t get_table_size() const {
+    return table16_.size() * sizeof(uint16_t) +
+           table32_.size() * sizeof(uint32_t);
+  }
+
+  // a compiled DFA cannot be modified.
+  int add_state() override;
+  void set_initial_state(int state) override;
+  void set_final_state(int state, bool is_final = true) override;
+  void add_transition(int from, const interpretation_map& symbol,
+                      int to) override;
+  void add_transition(int from, const interpretation& symbol, int to,
+                      bool dont_care = true) override;
+  void add_transition(int from, const interpretation_set& symbol, int to,
+                      bool dont_care = true) override;
+};
+
+} // namespace whitemech::lydia
@@ -0,0 +1,171 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <lydia/dfa/abstract_dfa.hpp>
+#include <lydia/dfa/dfa.hpp>
+#include <lydia/dfa/interpretation_bits.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * A decision diagram from interpretations to symbol classes.
+ *
+ * Two interpretations are in the same class if and only if they lead
+ * every state of the DFA to the same successor. The internal nodes test
+ * the variables in increasing order; a child is either another node
+ * (non-negative) or a class c (encoded as -c - 1).
+ */
+class AlphabetClassifier {
+public:
+  struct Node {
+    int variable;
+    int low;
+    int high;
+  };
+
+private:
+  int nb_variables_ = 0;
+  int root_ = -1;
+  std::vector<Node> nodes_;
+  std::vector<interpretation> representatives_;
+
+  friend class AlphabetClassifierBuilder;
+
+public:
+  /*!
+   * The class of a bit-packed interpretation, where the bit i of the
+   * word i / 64 is the truth value of the variable i.
+   */
+  int classify(const uint64_t* symbol) const {
+    int current = root_;
+    while (current >= 0) {
+      const auto& node = nodes_[current];
+      bool value = (symbol[node.variable >> 6] >> (node.variable & 63)) & 1;
+      current = value ? node.high : node.low;
+    }
+    return -current - 1;
+  }
+
+  /*!
+   * The class of an interpretation. The variables beyond its size
+   * are false.
+   */
+  int classify(const interpretation_bits& symbol) const {
+    if (symbol.size() >= (size_t)nb_variables_)
+      return classify(symbol.data());
+    int current = root_;
+    while (current >= 0) {
+      const auto& node = nodes_[current];
+      current = symbol.test(node.variable) ? node.high : node.low;
+    }
+    return -current - 1;
+  }
+
+  int classify(const interpretation& symbol) const;
+
+  int get_nb_variables() const { return nb_variables_; }
+  int get_nb_classes() const { return representatives_.size(); }
+  const std::vector<Node>& get_nodes() const { return nodes_; }
+  int get_root() const { return root_; }
+
+  /*!
+   * An interpretation of the class. The variables that do not matter
+   * are false.
+   */
+  const interpretation& get_representative(int symbol_class) const {
+    return representatives_[symbol_class];
+  }
+};
+
+/*!
+ * A read-only DFA whose transitions are stored in a table with one row
+ * per state and one column per symbol class (see AlphabetClassifier).
+ *
+ * Unlike compiled_dfa, the size of the table does not depend on the
+ * number of variables, but only on the number of distinct behaviours
+ * of the interpretations.
+ */
+class compressed_dfa : public abstract_dfa {
+private:
+  int nb_states_;
+  int initial_state_;
+  std::vector<bool> finals_;
+  AlphabetClassifier classifier_;
+  std::vector<uint32_t> table_;
+
+  void init_(const abstract_dfa& automaton);
+
+public:
+  /*!
+   * Compress a MONA DFA, with a simultaneous visit of the BDDs
+   * of all the states.
+   */
+  explicit compressed_dfa(const mona_dfa& automaton);
+
+  /*!
+   * Compress a CUDD DFA, by cofactoring the transition BDDs of all the
+   * states with the variables, in order.
+   */
+  explicit compressed_dfa(const dfa& automaton);
+
+  const AlphabetClassifier& get_classifier() const { return classifier_; }
+  int get_nb_classes() const { return classifier_.get_nb_classes(); }
+
+  int get_initial_state() const override { return initial_state_; }
+  int get_nb_states() const override { return nb_states_; }
+  int get_nb_variables() const override {
+    return classifier_.get_nb_variables();
+  }
+
+  /*!
+   * The successor of a state, for a symbol class.
+   */
+  int get_class_successor(int state, int symbol_class) const {
+    return table_[(size_t)state * get_nb_classes() + symbol_class];
+  }
+  int get_successor(int state, const interpretation& symbol) const override {
+    return get_class_successor(state, classifier_.classify(symbol));
+  }
+  int get_successor(int state,
+                    const interpretation_set& symbol) const override;
+  int get_successor(int state,
+                    const interpretation_bits& symbol) const override {
+    return get_class_successor(state, classifier_.classify(symbol));
+  }
+
+  bool is_final(int state) const override { return finals_[state]; }
+
+  using abstract_dfa::accepts;
+  bool accepts(const trace& word) const override;
+
+  // a compressed DFA cannot be modified.
+  int add_state() override;
+  void set_initial_state(int state) override;
+  void set_final_state(int state, bool is_final = true) override;
+  void add_transition(int from, const interpretation_map& symbol,
+                      int to) override;
+  void add_transition(int from, const interpretation& symbol, int to,
+                      bool dont_care = true) override;
+  void add_transition(int from, const interpretation_set& symbol, int to,
+                      bool dont_care = true) override;
+};
+
+} // namespace whitemech::lydia
@@ -32,6 +32,9 @@
 
 namespace whitemech::lydia {
 
+class mona_dfa;
+struct MonaDFAFile;
+
 class dfa : public abstract_dfa {
 private:
   int initial_state{};
@@ -83,8 +86,13 @@ public:
    * - set_initial_state
    * - set_final_state
    *
+   * The state encoding grows on demand: when a new state does not fit
+   * in the current number of bits, a new (most significant) bit
+   * variable is allocated. Hence, @nb_bits is only the initial
+   * number of bits, and it should be kept small.
+   *
    * @param mgr the CUDD manager.
-   * @param nb_bits the maximum number of bits available.
+   * @param nb_bits the initial number of bits (at least 1).
    * @param nb_variables the number of variables to be used.
    */
   dfa(const CUDD::Cudd& mgr, int nb_bits, int nb_variables);
@@ -114,6 +122,26 @@ public:
       int nb_states, int initial_state, const std::vector<int>& final_states,
       const std::vector<int>& behaviour, std::vector<item>& mona_bdd_nodes);
 
+  /*!
+   * Convert a MONA DFA, without going through the MONA file format.
+   *
+   * The nodes of the shared multi-terminal BDD of the MONA DFA are
+   * translated directly into CUDD BDDs of the given manager, with the
+   * same construction of dfa::read_from_file.
+   *
+   * @param mgr the CUDD manager
+   * @param automaton the MONA DFA. It is not modified.
+   */
+  dfa(const CUDD::Cudd& mgr, const mona_dfa& automaton);
+
+  /*!
+   * Constructor from the content of a MONA DFA file.
+   *
+   * @param mgr the CUDD manager
+   * @param file the parsed MONA DFA file.
+   */
+  dfa(const CUDD::Cudd& mgr, const MonaDFAFile& file);
+
   static Logger logger;
 
   // void initialize(string filename, string partfile, Cudd& manager);
@@ -121,6 +149,15 @@ public:
 
   CUDD::BDD state2bdd(int s);
 
+  /*!
+   * The bits of the successor of a state, as functions of the variables:
+   * the cofactors of the roots with respect to the encoding of the state.
+   *
+   * @param state the state.
+   * @return the bits of the successor, from the least significant.
+   */
+  vec_bdd get_successor_bits(int state) const;
+
   /*!
    *
    * Parse a MONA DFA file.
@@ -142,6 +179,7 @@ public:
    *
    * @return true if the word is accepted, false otherwise.
    */
+  using abstract_dfa::accepts;
   bool accepts(const trace& word) const override;
 
   int get_initial_state() const override { return initial_state; };
@@ -149,6 +187,8 @@ public:
   int get_nb_variables() const override { return nb_variables; };
   int get_successor(int state, const interpretation& symbol) const override;
   int get_successor(int state, const interpretation_set& symbol) const override;
+  int get_successor(int state,
+                    const interpretation_bits& symbol) const override;
 
   CUDD::BDD get_symbol(const interpretation_map&) const;
 
@@ -157,10 +197,24 @@ public:
   /*!
    * Add a new state.
    *
+   * If the new state cannot be represented with the current
+   * number of bits, a new bit is added (see dfa::add_bit).
+   *
    * @return the index of the next state.
    */
   int add_state() override;
 
+  /*!
+   * Add a new most significant bit to the state encoding.
+   *
+   * The new BDD variable is inserted in bddvars at position nb_bits.
+   * The existing transitions and final states are restricted to
+   * the states whose new bit is 0 (i.e. all the states so far),
+   * and the transition function of the new bit is initialized
+   * to the constant zero.
+   */
+  void add_bit();
+
   /*!
    * Set the initial state.
    *
@@ -213,10 +267,27 @@ public:
   void add_transition(int from, const interpretation_set& symbol, int to,
                       bool dont_care = true) override;
 
+  /*!
+   * The same the above, but with @guard as a BDD over the
+   * variables of the DFA (see dfa::prop2bddvar).
+   */
+  void add_transition(int from, const CUDD::BDD& guard, int to);
+
   CUDD::BDD prop2bddvar(int index, bool v) const;
 
 protected:
 private:
+  /*!
+   * Return an evaluation buffer for the BDDs of this DFA.
+   *
+   * Since bits can be added after the variables have been created,
+   * the position of a BDD variable in bddvars does not necessarily
+   * correspond to its index in the CUDD manager. The buffer is indexed
+   * by CUDD variable index, and must be populated with dfa::set_value.
+   */
+  std::vector<int> make_eval_buffer() const;
+  void set_value(std::vector<int>& buffer, int position, int value) const;
+
   void get_successor(const std::vector<int>& state,
                      const interpretation& symbol, std::vector<int>& next_state,
                      std::vector<int>& extended_symbol) const;
@@ -235,9 +306,8 @@ private:
    * @param mona_bdd_nodes
    * @return the list of BDDs.
    */
-  vec_bdd try_get(int index,
-                  const std::vector<std::vector<int>>& mona_bdd_nodes,
-                  std::vector<vec_bdd>& tBDD);
+  const vec_bdd& try_get(int index, const std::vector<int>& mona_bdd_nodes,
+                         std::vector<vec_bdd>& tBDD);
 
   /*!
    * Return positive or negative BDD variable from index.
@@ -249,6 +319,38 @@ private:
    */
   CUDD::BDD var2bddvar(int index, bool v = true) const;
 
+  /*!
+   * Create the BDD variables of the state bits and of the propositions,
+   * and the (zero) root BDDs.
+   */
+  void create_variables();
+
+  /*!
+   * Build the root BDDs and the BDD of the final states.
+   *
+   * Instead of OR-ing one cube per state into every root, the BDDs are
+   * built bottom-up with a multiplexer over the state bits, so every
+   * state contributes O(1) ITE operations per root.
+   *
+   * @param successors for every state, the BDDs of the bits
+   *       | of its successor.
+   * @param final_states the final states.
+   */
+  void assign_successors(const std::vector<vec_bdd>& successors,
+                         const std::vector<int>& final_states);
+
+  /*!
+   * Multiplex the leaves over the state bits 0..bit, for the states
+   * whose higher bits are given by offset.
+   *
+   * @param leaves for every state, the BDDs to select.
+   * @param bit the most significant bit still to decide.
+   * @param offset the (encoding of the) higher bits.
+   * @return the multiplexed BDDs.
+   */
+  vec_bdd multiplex(const std::vector<vec_bdd>& leaves, int bit,
+                    int offset) const;
+
   /*!
    * This method builds the Symbolic DFA from MONA BDD nodes.
    *
@@ -267,5 +369,13 @@ private:
   construct_bdd_from_mona(const std::vector<std::vector<int>>& mona_bdd_nodes,
                           const std::vector<int>& behaviour,
                           const std::vector<int>& final_states);
+
+  /*!
+   * Same as above, but the BDD specifications are stored in a flat
+   * array, three integers per node.
+   */
+  void construct_bdd_from_mona(const std::vector<int>& mona_bdd_nodes,
+                               const std::vector<int>& behaviour,
+                               const std::vector<int>& final_states);
 };
 } // namespace whitemech::lydia
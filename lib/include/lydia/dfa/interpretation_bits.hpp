@@ -0,0 +1,123 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <lydia/types.hpp>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * A propositional interpretation, as a bitset: the bit i is the truth
+ * value of the variable i.
+ *
+ * Up to 64 * INLINE_WORDS variables, the bits are stored inline, so
+ * that creating, copying and updating an interpretation does not
+ * allocate memory.
+ */
+class interpretation_bits {
+public:
+  static const size_t INLINE_WORDS = 2;
+
+private:
+  size_t size_ = 0;
+  uint64_t inline_[INLINE_WORDS] = {0, 0};
+  std::vector<uint64_t> heap_;
+
+public:
+  interpretation_bits() = default;
+
+  /*!
+   * All the variables are false.
+   */
+  explicit interpretation_bits(size_t size) : size_{size} {
+    if (get_nb_words() > INLINE_WORDS)
+      heap_.assign(get_nb_words(), 0);
+  }
+
+  explicit interpretation_bits(const interpretation& symbol)
+      : interpretation_bits(symbol.size()) {
+    for (size_t i = 0; i < symbol.size(); i++)
+      if (symbol[i])
+        set(i);
+  }
+
+  /*!
+   * @param size the number of variables.
+   * @param symbol the variables that are true. The ones that are not
+   *      | smaller than the size are ignored.
+   */
+  interpretation_bits(size_t size, const interpretation_set& symbol)
+      : interpretation_bits(size) {
+    for (int variable : symbol)
+      if (variable >= 0 && (size_t)variable < size)
+        set(variable);
+  }
+
+  size_t size() const { return size_; }
+  size_t get_nb_words() const { return (size_ + 63) / 64; }
+
+  /*!
+   * The words of the bitset. There are at least INLINE_WORDS of them,
+   * and the bits beyond the size are zero.
+   */
+  const uint64_t* data() const {
+    return heap_.empty() ? inline_ : heap_.data();
+  }
+
+  bool operator[](size_t i) const { return (data()[i >> 6] >> (i & 63)) & 1; }
+
+  /*!
+   * The same as operator[], but the variables beyond the size are false.
+   */
+  bool test(size_t i) const { return i < size_ && (*this)[i]; }
+
+  void set(size_t i, bool value = true) {
+    uint64_t* words = heap_.empty() ? inline_ : heap_.data();
+    if (value)
+      words[i >> 6] |= uint64_t(1) << (i & 63);
+    else
+      words[i >> 6] &= ~(uint64_t(1) << (i & 63));
+  }
+
+  void clear() {
+    std::fill(inline_, inline_ + INLINE_WORDS, 0);
+    std::fill(heap_.begin(), heap_.end(), 0);
+  }
+
+  interpretation to_interpretation() const {
+    interpretation result(size_);
+    for (size_t i = 0; i < size_; i++)
+      result[i] = (*this)[i];
+    return result;
+  }
+
+  bool operator==(const interpretation_bits& other) const {
+    if (size_ != other.size_)
+      return false;
+    return std::equal(data(), data() + get_nb_words(), other.data());
+  }
+  bool operator!=(const interpretation_bits& other) const {
+    return !(*this == other);
+  }
+};
+
+typedef std::vector<interpretation_bits> trace_bits;
+
+} // namespace whitemech::lydia
@@ -61,6 +61,7 @@ public:
   int get_nb_states() const override;
   int get_nb_variables() const override;
 
+  using abstract_dfa::accepts;
   bool accepts(const trace& word) const override {
     int current_state = get_initial_state();
     for (const auto& symbol : word) {
@@ -71,24 +72,22 @@ public:
 
   int get_successor(int state, const interpretation& symbol) const override;
   int get_successor(int state,
-                    const interpretation_set& symbol) const override{};
+                    const interpretation_set& symbol) const override;
+  int get_successor(int state,
+                    const interpretation_bits& symbol) const override;
 
   bool is_final(int state) const override;
 
-  virtual int add_state(){};
-
-  void set_initial_state(int state) override{};
-
-  void set_final_state(int state, bool is_final = true) override{};
-
+  // a MONA DFA cannot be modified: use the MONA API on dfa_ instead.
+  int add_state() override;
+  void set_initial_state(int state) override;
+  void set_final_state(int state, bool is_final = true) override;
   void add_transition(int from, const interpretation_map& symbol,
-                      int to) override{};
-
+                      int to) override;
   void add_transition(int from, const interpretation& symbol, int to,
-                      bool dont_care = true) override{};
-
+                      bool dont_care = true) override;
   void add_transition(int from, const interpretation_set& symbol, int to,
-                      bool dont_care = true) override{};
+                      bool dont_care = true) override;
 
   void export_dfa(const std::string& filename) const;
 };
@@ -0,0 +1,86 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * The content of a MONA DFA file, in flat arrays.
+ *
+ * Please check Appendix C of the MONA User Manual [1].
+ *
+ * [1] MONA User Manual. https://www.brics.dk/mona/mona14.pdf
+ */
+struct MonaDFAFile {
+  std::vector<std::string> variables;
+  int nb_states = -1;
+  int initial_state = -1;
+  std::vector<int> final_states;
+  std::vector<int> behaviour;
+  /*!
+   * The BDD nodes, three integers per node: "-1 val 0" for a leaf
+   * with value val, "x l r" for an internal node with index x,
+   * left (low) successor l and right (high) successor r.
+   */
+  std::vector<int> bdd_nodes;
+
+  int get_nb_nodes() const { return bdd_nodes.size() / 3; }
+};
+
+/*!
+ * Check that the shared multi-terminal BDD of a MONA DFA is consistent:
+ * the variable indices, the references to the nodes, the values of the
+ * leaves, the behaviours and the final states are in range, and no node
+ * is reachable from itself.
+ *
+ * @param bdd_nodes the BDD nodes, three integers per node.
+ * @param nb_variables the number of variables.
+ * @param nb_states the number of states.
+ * @param behaviour the root node of every state.
+ * @param final_states the final states.
+ * @throw std::runtime_error if the DFA is not consistent.
+ */
+void check_mona_bdd(const std::vector<int>& bdd_nodes, int nb_variables,
+                    int nb_states, const std::vector<int>& behaviour,
+                    const std::vector<int>& final_states);
+
+/*!
+ * Parse a MONA DFA file.
+ *
+ * The file is memory-mapped and tokenized in place: no line or token
+ * is copied, except the names of the variables.
+ *
+ * @param filename path to the MONA DFA file.
+ * @return the content of the file.
+ * @throw std::runtime_error if the file cannot be read or is malformed.
+ */
+MonaDFAFile parse_mona_dfa_file(const std::string& filename);
+
+/*!
+ * Same as parse_mona_dfa_file, on a buffer already in memory.
+ *
+ * @param begin the start of the buffer.
+ * @param end the end of the buffer.
+ * @return the content of the buffer.
+ * @throw std::runtime_error if the buffer is malformed.
+ */
+MonaDFAFile parse_mona_dfa(const char* begin, const char* end);
+
+} // namespace whitemech::lydia
@@ -0,0 +1,72 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cuddObj.hh>
+#include <functional>
+#include <lydia/dfa/dfa.hpp>
+#include <map>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * A memoized walk of the decision diagram shared by the successor bits
+ * of one or more states of a dfa (see dfa::get_successor_bits).
+ *
+ * At every node, the bits are split on the first variable they depend
+ * on; a leaf is reached when all of them are constant. The results are
+ * built bottom-up by the given functions:
+ * - make_leaf receives the successor of every state, one per group of
+ *   nb_bits bits, and an interpretation that leads to the leaf (the
+ *   variables not tested on the path are false);
+ * - make_node receives the position of the variable and the results
+ *   of the low and high children.
+ *
+ * A node is identified by the BDD nodes of its bits, so a node shared
+ * by several walks on the same walker is visited only once.
+ */
+class SuccessorBitsWalker {
+public:
+  using leaf_function =
+      std::function<int(const std::vector<int>&, const interpretation&)>;
+  using node_function = std::function<int(int, int, int)>;
+
+  SuccessorBitsWalker(const dfa& automaton, leaf_function make_leaf,
+                      node_function make_node);
+
+  /*!
+   * @param bits the successor bits of some states, state by state.
+   * @return the result of the root.
+   */
+  int walk(const vec_bdd& bits) { return walk_(bits, 0); }
+
+private:
+  const dfa& automaton_;
+  leaf_function make_leaf_;
+  node_function make_node_;
+  std::map<std::vector<DdNode*>, int> memo_;
+  // the visited bits are kept alive, so that the pointers in the keys of
+  // memo_ are not recycled.
+  std::vector<vec_bdd> alive_;
+  // the interpretation of the path being visited.
+  interpretation path_;
+
+  int walk_(const vec_bdd& bits, int position);
+};
+
+} // namespace whitemech::lydia
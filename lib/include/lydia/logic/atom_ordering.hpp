@@ -0,0 +1,134 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lydia/logic/ldlf/base.hpp>
+#include <lydia/types.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * Heuristic for the order of the atoms of a formula.
+ *
+ * The position of an atom in the order is the identifier of its
+ * variable in the automata built by the strategies, hence it decides
+ * the variable order of their BDDs.
+ */
+class AtomOrdering {
+public:
+  virtual ~AtomOrdering() = default;
+
+  /*!
+   * Order the atoms of a formula.
+   *
+   * @param formula the formula (in NNF).
+   * @param atoms the atoms of the formula.
+   * @return a permutation of the atoms.
+   */
+  virtual std::vector<atom_ptr> order(const LDLfFormula& formula,
+                                      const set_atoms_ptr& atoms) const = 0;
+
+  /*!
+   * @return a description of the heuristic and of its parameters,
+   *       | used to key the translations in TranslationCache.
+   */
+  virtual std::string signature() const = 0;
+};
+
+/*!
+ * The atoms in lexicographic order of their names (the default).
+ */
+class LexicographicOrdering : public AtomOrdering {
+public:
+  std::vector<atom_ptr> order(const LDLfFormula& formula,
+                              const set_atoms_ptr& atoms) const override;
+  std::string signature() const override { return "lexicographic"; }
+};
+
+/*!
+ * The FORCE heuristic (Aloul, Markov, Sakallah) on the co-occurrence
+ * hypergraph of the formula.
+ *
+ * There is an hyperedge for the atoms of every propositional formula,
+ * and one for every pair of consecutive elements of a sequence.
+ * At every iteration, each atom is moved to the average center of
+ * gravity of its hyperedges; the order with the minimum total span
+ * is returned.
+ */
+class ForceOrdering : public AtomOrdering {
+public:
+  size_t max_iterations;
+
+  explicit ForceOrdering(size_t max_iterations = 32)
+      : max_iterations{max_iterations} {}
+
+  std::vector<atom_ptr> order(const LDLfFormula& formula,
+                              const set_atoms_ptr& atoms) const override;
+  std::string signature() const override {
+    return "force(" + std::to_string(max_iterations) + ")";
+  }
+};
+
+/*!
+ * Interleave groups of related atoms, e.g. the inputs and the outputs
+ * of a synthesis problem: the first atom of every group, then the second
+ * atom of every group, and so on.
+ *
+ * The groups are lists of atom names; the names that do not occur in
+ * the formula are skipped. The atoms that are not in any group follow,
+ * in the order given by the base heuristic.
+ */
+class InterleavedOrdering : public AtomOrdering {
+public:
+  std::vector<std::vector<std::string>> groups;
+  std::shared_ptr<AtomOrdering> base;
+
+  explicit InterleavedOrdering(
+      std::vector<std::vector<std::string>> groups,
+      std::shared_ptr<AtomOrdering> base =
+          std::make_shared<LexicographicOrdering>())
+      : groups{std::move(groups)}, base{std::move(base)} {}
+
+  std::vector<atom_ptr> order(const LDLfFormula& formula,
+                              const set_atoms_ptr& atoms) const override;
+  std::string signature() const override;
+};
+
+/*!
+ * Compute the hyperedges of the co-occurrence hypergraph used by
+ * ForceOrdering. Hyperedges with less than two atoms are dropped.
+ *
+ * @param formula the formula.
+ * @return the hyperedges, as sets of atoms.
+ */
+std::vector<set_atoms_ptr> atom_hyperedges(const LDLfFormula& formula);
+
+/*!
+ * The total span of the hyperedges, i.e. the sum over the hyperedges
+ * of the distance between their first and last atom in the order.
+ *
+ * @param order an order of the atoms.
+ * @param hyperedges the hyperedges.
+ * @return the total span.
+ */
+size_t total_span(const std::vector<atom_ptr>& order,
+                  const std::vector<set_atoms_ptr>& hyperedges);
+
+} // namespace whitemech::lydia
@@ -18,6 +18,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <lydia/dfa/abstract_dfa.hpp>
 #include <numeric>
 #include <set>
 #include <string>
@@ -36,10 +37,44 @@ DFA* dfaUniversalProject(DFA* a, unsigned var_index);
 
 namespace whitemech::lydia {
 
+/*!
+ * Concatenation of two DFAs.
+ *
+ * The result is built directly from the BDDs of the operands,
+ * with a subset construction. The operands are not freed.
+ *
+ * @param a the DFA of the prefix.
+ * @param b the DFA of the suffix.
+ * @param n the number of variables (unused, kept for compatibility).
+ * @param indices the variable indices (unused, kept for compatibility).
+ * @return the minimized DFA of the concatenation.
+ */
 DFA* dfa_concatenate(DFA* a, DFA* b, int n, int* indices);
 
+/*!
+ * Closure (Kleene plus) of a DFA.
+ *
+ * As dfa_concatenate, it works directly on the BDDs of the operand.
+ * The empty word is accepted only if it is accepted by the operand.
+ *
+ * @param a the DFA.
+ * @param n the number of variables (unused, kept for compatibility).
+ * @param indices the variable indices (unused, kept for compatibility).
+ * @return the minimized DFA of the closure.
+ */
 DFA* dfa_closure(DFA* a, int n, int* indices);
 
+/*!
+ * Same as dfa_concatenate, but the transitions are enumerated as string
+ * guards and rebuilt with an extra variable, which is projected away.
+ */
+DFA* dfa_concatenate_with_guards(DFA* a, DFA* b, int n, int* indices);
+
+/*!
+ * Same as dfa_closure, but built from string guards.
+ */
+DFA* dfa_closure_with_guards(DFA* a, int n, int* indices);
+
 DFA* only_empty();
 
 DFA* dfa_accept_empty(DFA* x);
@@ -58,8 +93,45 @@ DFA* dfaLDLfEnd(int var, int* indices);
 
 DFA* dfaPropositionalTrue();
 
+/*!
+ * Check whether a DFA accepts every word (if is_positive) or no word.
+ *
+ * The DFA need not be minimized: all the states reachable from the
+ * initial state must be final (resp. non-final).
+ *
+ * @param automaton the DFA.
+ * @param is_positive whether to check for the accepting sink.
+ * @return true if the language of the DFA is universal (resp. empty).
+ */
 bool is_sink(DFA* automaton, bool is_positive = true);
 
+/*!
+ * Build a MONA DFA equivalent to an arbitrary DFA.
+ *
+ * The transitions are computed by enumerating all the interpretations,
+ * so this should be used only with a small number of variables.
+ * The variable i of the automaton is mapped to the MONA index i,
+ * and the states (including the initial one) keep their numbers.
+ *
+ * @param automaton the DFA.
+ * @return the MONA DFA.
+ */
+DFA* dfa_from_abstract_dfa(const abstract_dfa& automaton);
+
+/*!
+ * Compute the synchronous product of several DFAs in one pass.
+ *
+ * Only the tuples of states reachable from the initial tuple are built,
+ * and all the tuples containing a dominant sink (a rejecting sink for
+ * the conjunction, an accepting sink for the disjunction) are collapsed
+ * into a single state. The result is not minimized.
+ *
+ * @param dfas the operands. They are not freed.
+ * @param type either dfaAND or dfaOR.
+ * @return the product DFA.
+ */
+DFA* dfa_nary_product(const std::vector<DFA*>& dfas, dfaProductType type);
+
 void print_mona_dfa(DFA* a, const std::string& name, int num = 1);
 
 void dfaPrintGraphvizToFile(DFA* a, int no_free_vars, unsigned* offsets,
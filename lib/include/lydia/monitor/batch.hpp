@@ -0,0 +1,88 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <lydia/dfa/batch.hpp>
+#include <lydia/dfa/compiled_dfa.hpp>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * Many instances of the same monitor, stepped together.
+ *
+ * The current states of all the instances are kept in a contiguous
+ * array, and a step takes one encoded interpretation per instance (see
+ * compiled_dfa::encode). The transition table is copied from the compiled
+ * DFA with 32-bit entries, so that, when the library is built with AVX2,
+ * eight instances are advanced at once with a gather. There is no
+ * virtual call per instance.
+ *
+ * After every step, the instances in a final state and in a sink
+ * (see classify_states) are reported as bitmaps.
+ */
+class MonitorBatch {
+private:
+  static const uint32_t FINAL = 1;
+  static const uint32_t SINK = 2;
+
+  int nb_variables_;
+  uint32_t initial_state_;
+  std::vector<uint32_t> table_;
+  // FINAL and/or SINK, for every state.
+  std::vector<uint32_t> status_;
+  std::vector<uint32_t> states_;
+  VerdictBitmap finals_;
+  VerdictBitmap sinks_;
+
+  void update_verdicts_();
+
+public:
+  /*!
+   * @param automaton the compiled DFA.
+   * @param nb_instances the number of instances, all in the initial state.
+   * @throw std::invalid_argument if the table has 2^31 entries or more.
+   */
+  MonitorBatch(const compiled_dfa& automaton, size_t nb_instances);
+
+  size_t size() const { return states_.size(); }
+  int get_nb_variables() const { return nb_variables_; }
+
+  /*!
+   * Advance every instance.
+   *
+   * @param symbols the encoded interpretation of every instance. The bits
+   *      | beyond the number of variables must be zero.
+   */
+  void step(const uint32_t* symbols);
+  void step(const std::vector<uint32_t>& symbols);
+
+  /*!
+   * Put all the instances, or one of them, back in the initial state.
+   */
+  void reset();
+  void reset(size_t instance);
+
+  const std::vector<uint32_t>& get_states() const { return states_; }
+  const VerdictBitmap& get_finals() const { return finals_; }
+  const VerdictBitmap& get_sinks() const { return sinks_; }
+  bool is_final(size_t instance) const { return finals_[instance]; }
+  bool is_sink(size_t instance) const { return sinks_[instance]; }
+};
+
+} // namespace whitemech::lydia
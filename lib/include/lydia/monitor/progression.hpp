@@ -0,0 +1,129 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lydia/logic/ldlf/base.hpp>
+#include <lydia/logic/ltlf/base.hpp>
+#include <lydia/types.hpp>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * The verdicts of a monitor, as in RV-LTL.
+ *
+ * A verdict is permanent if it holds for every extension of the
+ * observed trace, and presumable if it holds only if the trace ends now.
+ */
+enum class MonitorVerdict {
+  permanently_true,
+  permanently_false,
+  presumably_true,
+  presumably_false
+};
+
+inline bool is_permanent(MonitorVerdict verdict) {
+  return verdict == MonitorVerdict::permanently_true ||
+         verdict == MonitorVerdict::permanently_false;
+}
+
+std::string to_string(MonitorVerdict verdict);
+
+/*!
+ * A monitor that rewrites the formula by progression, without
+ * building any automaton.
+ *
+ * At every step, the current formula is replaced by delta(phi, i),
+ * where the quoted formulas are put back as LDLf formulas. Since the
+ * AST nodes are hash-consed, equal formulas are the same object, and
+ * the progression is memoized on the pair (formula, interpretation).
+ *
+ * The verdict is permanently true (resp. false) when the current formula
+ * is tt (resp. ff), and presumably true or false according to whether
+ * the formula accepts the empty trace otherwise. The permanent verdicts
+ * are detected only syntactically, so a formula that is valid (or
+ * unsatisfiable) but not simplified to tt (or ff) gives a presumable
+ * verdict. Once the verdict is permanent, the next steps are ignored.
+ *
+ * The variable i of an interpretation is the i-th atom of the formula,
+ * in lexicographic order (see get_atoms).
+ */
+class ProgressionMonitor {
+private:
+  ldlf_ptr initial_formula_;
+  ldlf_ptr formula_;
+  std::vector<atom_ptr> id2atoms_;
+  MonitorVerdict verdict_;
+  size_t nb_steps_ = 0;
+
+  // the shared pointers in the keys keep the formulas alive, so that
+  // their addresses cannot be reused by other formulas.
+  std::map<std::pair<ldlf_ptr, std::vector<bool>>, ldlf_ptr> progressions_;
+  std::map<ldlf_ptr, MonitorVerdict> verdicts_;
+
+  MonitorVerdict compute_verdict_(const ldlf_ptr& formula);
+  void step_(const std::vector<bool>& key);
+
+public:
+  explicit ProgressionMonitor(const LDLfFormula& formula);
+  explicit ProgressionMonitor(const LTLfFormula& formula);
+
+  const std::vector<atom_ptr>& get_atoms() const { return id2atoms_; }
+  int get_nb_variables() const { return id2atoms_.size(); }
+
+  /*!
+   * Observe the next interpretation.
+   *
+   * @param true_atoms the atoms that are true. The atoms that do
+   *      | not occur in the formula are ignored.
+   * @return the verdict after the observation.
+   */
+  MonitorVerdict step(const set_atoms_ptr& true_atoms);
+
+  /*!
+   * Observe the next interpretation.
+   *
+   * @param symbol the truth value of every variable.
+   * @return the verdict after the observation.
+   */
+  MonitorVerdict step(const interpretation& symbol);
+
+  /*!
+   * Observe a sequence of interpretations, stopping as soon as the
+   * verdict is permanent.
+   *
+   * @return the verdict after the observations.
+   */
+  MonitorVerdict run(const trace& word);
+
+  MonitorVerdict get_verdict() const { return verdict_; }
+  bool is_permanent() const { return lydia::is_permanent(verdict_); }
+
+  /*!
+   * Go back to the initial formula. The memoized progressions are kept.
+   */
+  void reset();
+
+  const ldlf_ptr& get_current_formula() const { return formula_; }
+  size_t get_nb_steps() const { return nb_steps_; }
+  size_t get_nb_formulas() const { return verdicts_.size(); }
+};
+
+} // namespace whitemech::lydia
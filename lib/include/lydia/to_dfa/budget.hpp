@@ -0,0 +1,111 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace whitemech::lydia {
+
+enum class BudgetViolation { cancelled, deadline, dfa_states, bdd_nodes };
+
+/*!
+ * Statistics collected by a TranslationBudget during a translation.
+ */
+struct TranslationStatistics {
+  size_t nb_checks = 0;
+  size_t nb_intermediate_dfas = 0;
+  size_t max_dfa_states = 0;
+  size_t max_bdd_nodes = 0;
+  std::chrono::milliseconds elapsed{0};
+};
+
+/*!
+ * Raised when a translation exceeds its budget.
+ *
+ * It carries the statistics collected up to the violation.
+ */
+class budget_exceeded_error : public std::runtime_error {
+public:
+  const BudgetViolation violation;
+  const TranslationStatistics statistics;
+
+  budget_exceeded_error(BudgetViolation violation,
+                        const TranslationStatistics& statistics);
+};
+
+/*!
+ * Limits on the resources of a translation, and cancellation token.
+ *
+ * A budget is passed to a Translator, which starts it and makes it
+ * available to the strategy. The strategies check it cooperatively
+ * at every explored state or intermediate DFA, and raise
+ * a budget_exceeded_error when a limit is violated.
+ *
+ * A zero limit means no limit. The method cancel() can be called
+ * from another thread.
+ */
+class TranslationBudget {
+private:
+  std::chrono::milliseconds timeout_{0};
+  size_t max_dfa_states_ = 0;
+  size_t max_bdd_nodes_ = 0;
+  std::atomic<bool> cancelled_{false};
+  std::chrono::steady_clock::time_point start_;
+  TranslationStatistics statistics_;
+
+  [[noreturn]] void fail_(BudgetViolation violation);
+
+public:
+  TranslationBudget& set_timeout(std::chrono::milliseconds timeout);
+  TranslationBudget& set_max_dfa_states(size_t max_dfa_states);
+  TranslationBudget& set_max_bdd_nodes(size_t max_bdd_nodes);
+
+  /*!
+   * Reset the statistics and start the clock for the timeout.
+   */
+  void start();
+
+  /*!
+   * Request the cancellation of the translation.
+   */
+  void cancel() { cancelled_ = true; }
+  bool is_cancelled() const { return cancelled_; }
+
+  /*!
+   * Check the cancellation and the deadline.
+   *
+   * @throw budget_exceeded_error if the budget is exceeded.
+   */
+  void check();
+
+  /*!
+   * Record an intermediate DFA, and check all the limits.
+   *
+   * @param nb_states the number of states of the DFA.
+   * @param nb_bdd_nodes the number of BDD nodes used by the DFA.
+   * @throw budget_exceeded_error if the budget is exceeded.
+   */
+  void check(size_t nb_states, size_t nb_bdd_nodes);
+
+  const TranslationStatistics& get_statistics() const { return statistics_; }
+};
+
+} // namespace whitemech::lydia
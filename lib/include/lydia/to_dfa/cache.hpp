@@ -0,0 +1,121 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <lydia/logger.hpp>
+#include <lydia/to_dfa/core.hpp>
+#include <memory>
+#include <string>
+
+namespace whitemech::lydia {
+
+struct TranslationCacheStatistics {
+  size_t nb_hits = 0;
+  size_t nb_misses = 0;
+  size_t nb_stores = 0;
+  size_t nb_evictions = 0;
+  /*! Entries discarded because they could not be read. */
+  size_t nb_invalid = 0;
+  /*! Entries that could not be written. */
+  size_t nb_failed_stores = 0;
+
+  double hit_rate() const {
+    size_t nb_lookups = nb_hits + nb_misses;
+    return nb_lookups == 0 ? 0.0 : double(nb_hits) / nb_lookups;
+  }
+};
+
+/*!
+ * A persistent cache of translations, in a local directory.
+ *
+ * A translation is keyed by the signature of the strategy and by the
+ * string of the NNF of the formula. The key does not depend on the
+ * AST manager, so it is the same across runs. Every entry is a file
+ * named after the hash of the key, which contains the key itself
+ * (to detect collisions) and the minimized DFA, in the binary format.
+ *
+ * When the directory grows over the maximum size, the least recently
+ * used entries are removed. An entry is used when it is stored or
+ * found; the time of the last use is the modification time of the file,
+ * so the order is kept across runs.
+ */
+class TranslationCache {
+private:
+  std::filesystem::path directory_;
+  std::uintmax_t max_size_;
+  TranslationCacheStatistics statistics_;
+
+  std::filesystem::path entry_path_(const std::string& key) const;
+  void evict_();
+
+public:
+  static Logger logger;
+
+  /*!
+   * @param directory the directory of the cache. It is created
+   *      | if it does not exist.
+   * @param max_size the maximum size of the entries, in bytes.
+   */
+  explicit TranslationCache(const std::string& directory,
+                            std::uintmax_t max_size = 256 * 1024 * 1024);
+
+  /*!
+   * @return the key of the translation, or the empty string if the
+   *       | strategy has no signature.
+   */
+  static std::string make_key(const LDLfFormula& formula,
+                              const Strategy& strategy);
+
+  /*!
+   * Find a translation.
+   *
+   * @param key the key of the translation.
+   * @param strategy the strategy, to build the DFA.
+   * @return the DFA, or nullptr if it is not in the cache.
+   */
+  std::shared_ptr<abstract_dfa> lookup(const std::string& key,
+                                       const Strategy& strategy);
+
+  /*!
+   * Store a translation. The DFA is minimized before being written.
+   *
+   * If the entry cannot be written, no entry is left for the key, and
+   * the failure is counted in the statistics.
+   *
+   * @throw std::runtime_error if the entry cannot be written.
+   */
+  void store(const std::string& key, const abstract_dfa& automaton);
+
+  /*!
+   * @return the total size of the entries, in bytes.
+   */
+  std::uintmax_t get_size() const;
+
+  /*!
+   * Remove all the entries.
+   */
+  void clear();
+
+  const TranslationCacheStatistics& get_statistics() const {
+    return statistics_;
+  }
+  void reset_statistics() { statistics_ = TranslationCacheStatistics(); }
+};
+
+} // namespace whitemech::lydia
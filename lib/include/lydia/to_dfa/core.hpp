@@ -17,25 +17,84 @@
  */
 
 #include <lydia/dfa/dfa.hpp>
+#include <lydia/to_dfa/budget.hpp>
 #include <memory>
+#include <string>
 
 namespace whitemech::lydia {
 
+class TranslationCache;
+
 class Strategy {
+protected:
+  TranslationBudget* budget_ = nullptr;
+
+  /*!
+   * Check the budget, if any. To be called at every explored state.
+   */
+  void check_budget_() {
+    if (budget_)
+      budget_->check();
+  }
+
+  /*!
+   * Check the budget, if any. To be called at every intermediate DFA.
+   */
+  void check_budget_(size_t nb_states, size_t nb_bdd_nodes) {
+    if (budget_)
+      budget_->check(nb_states, nb_bdd_nodes);
+  }
+
 public:
   virtual std::shared_ptr<abstract_dfa> to_dfa(const LDLfFormula& f) = 0;
+
+  /*!
+   * Describe the strategy and the options that change its result,
+   * e.g. the order of the variables. Used to key the translations
+   * in a TranslationCache.
+   *
+   * @return the signature, or the empty string if the results
+   *       | of the strategy must not be cached (the default).
+   */
+  virtual std::string signature() const { return ""; }
+
+  /*!
+   * Build a DFA of the kind returned by the strategy, from the content
+   * of a DFA file. By default, a mona_dfa.
+   */
+  virtual std::shared_ptr<abstract_dfa> load(const MonaDFAFile& file) const;
+
+  void set_budget(TranslationBudget* budget) { budget_ = budget; }
 };
 
 class Translator {
 private:
   Strategy& strategy;
+  TranslationBudget* budget;
+  TranslationCache* cache;
+
+  std::shared_ptr<abstract_dfa> translate_(const LDLfFormula& f) const;
 
 public:
-  explicit Translator(Strategy& strategy) : strategy{strategy} {}
+  /*!
+   * @param strategy the translation strategy.
+   * @param budget the budget of every translation, or nullptr
+   *      | for no budget.
+   * @param cache the cache of the translations, or nullptr for no cache.
+   *      | It is used only if the strategy has a signature.
+   */
+  explicit Translator(Strategy& strategy, TranslationBudget* budget = nullptr,
+                      TranslationCache* cache = nullptr)
+      : strategy{strategy}, budget{budget}, cache{cache} {}
 
-  std::shared_ptr<abstract_dfa> to_dfa(const LDLfFormula& f) const {
-    return strategy.to_dfa(f);
-  }
+  /*!
+   * Translate the formula.
+   *
+   * If the translation is found in the cache, the budget is not checked.
+   *
+   * @throw budget_exceeded_error if the budget is exceeded.
+   */
+  std::shared_ptr<abstract_dfa> to_dfa(const LDLfFormula& f) const;
 };
 
 /*!
@@ -58,9 +58,15 @@ public:
    * construction this is equivalent to check if the NFA state
    * {true} is in the state (after applying the delta function).
    *
+   * The result is computed once, and then cached.
+   *
    * @return whether the state is final or not.
    */
   bool is_final() const;
+
+private:
+  // -1: not computed yet; 0: not final; 1: final.
+  mutable int is_final_ = -1;
 };
 
 } // namespace whitemech::lydia
\ No newline at end of file
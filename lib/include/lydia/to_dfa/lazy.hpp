@@ -0,0 +1,109 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+#include <lydia/logic/ldlf/base.hpp>
+#include <lydia/to_dfa/dfa_state.hpp>
+#include <lydia/types.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace whitemech::lydia {
+
+struct LazyDFAStatistics {
+  size_t nb_hits = 0;
+  size_t nb_misses = 0;
+  size_t nb_evictions = 0;
+};
+
+/*!
+ * A DFA whose states and transitions are computed on demand.
+ *
+ * The states are the DFA states of the on-the-fly construction, and
+ * the successor for a concrete interpretation is computed as in
+ * NaiveStrategy::next_state. The visited states are interned in a cache
+ * with a bounded number of states, together with the successors already
+ * computed; when the bound is exceeded, the least recently used state
+ * is evicted. An evicted state is still valid: only its memoized
+ * transitions are lost. Hence, the memory depends on the visited states
+ * and on the bound, rather than on the size of the full DFA.
+ *
+ * The variable i of an interpretation is the i-th atom of the formula,
+ * in lexicographic order (see get_atoms).
+ */
+class LazyDFA {
+private:
+  struct StateHash {
+    size_t operator()(const dfa_state_ptr& s) const { return s->hash(); }
+  };
+  struct StateEqual {
+    bool operator()(const dfa_state_ptr& lhs, const dfa_state_ptr& rhs) const {
+      return lhs == rhs || lhs->is_equal(*rhs);
+    }
+  };
+  struct Entry {
+    dfa_state_ptr state;
+    std::unordered_map<std::vector<bool>, dfa_state_ptr> successors;
+  };
+
+  ldlf_ptr formula_;
+  std::vector<atom_ptr> id2atoms_;
+  dfa_state_ptr initial_state_;
+  size_t max_cached_states_;
+  // the most recently used entry is at the front.
+  std::list<Entry> entries_;
+  std::unordered_map<dfa_state_ptr, std::list<Entry>::iterator, StateHash,
+                     StateEqual>
+      index_;
+  LazyDFAStatistics statistics_;
+
+  std::list<Entry>::iterator intern_(const dfa_state_ptr& state);
+  void shrink_();
+
+public:
+  /*!
+   * @param formula the LDLf formula.
+   * @param max_cached_states the maximum number of cached states
+   *      | (at least 1).
+   */
+  explicit LazyDFA(const LDLfFormula& formula, size_t max_cached_states = 1024);
+
+  const std::vector<atom_ptr>& get_atoms() const { return id2atoms_; }
+  int get_nb_variables() const { return id2atoms_.size(); }
+
+  dfa_state_ptr get_initial_state() const { return initial_state_; }
+
+  /*!
+   * Compute the successor of a state.
+   *
+   * @param state the state.
+   * @param symbol the truth value of every variable.
+   * @return the successor.
+   */
+  dfa_state_ptr get_successor(const dfa_state_ptr& state,
+                              const interpretation& symbol);
+
+  bool is_final(const dfa_state_ptr& state) const { return state->is_final(); }
+
+  bool accepts(const trace& word);
+
+  size_t get_nb_cached_states() const { return entries_.size(); }
+  const LazyDFAStatistics& get_statistics() const { return statistics_; }
+};
+
+} // namespace whitemech::lydia
@@ -60,9 +60,16 @@ public:
    * after having applied the delta function with epsilon to each of them,
    * reduces to True.
    *
+   * The result is computed once, and then cached.
+   *
    * @return whether the NFA state is final.
    */
   bool is_final() const;
+
+private:
+  // -1: not computed yet; 0: not final; 1: final.
+  mutable int is_final_ = -1;
+  bool compute_is_final_() const;
 };
 
 } // namespace whitemech::lydia
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lydia/to_dfa/dfa_state.hpp>
+#include <lydia/to_dfa/nfa_state.hpp>
+#include <lydia/types.hpp>
+#include <utility>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * Interning table for the DFA states discovered during the
+ * on-the-fly construction.
+ *
+ * Every NFA state is assigned a unique integer identifier, and a DFA state
+ * is keyed by the sorted vector of the identifiers of its NFA states.
+ * Both tables use open addressing with linear probing, and the probe
+ * sequence starts from the (cached) hash of the NFA/DFA state, so that
+ * comparing two keys never walks the nested sets of formulas.
+ */
+class StateTable {
+public:
+  explicit StateTable(size_t initial_capacity = 64);
+
+  /*!
+   * Find the DFA state, or insert it with the given value.
+   *
+   * Only one probe sequence is performed.
+   *
+   * @param state the DFA state.
+   * @param value the value to associate to the state, if not present.
+   * @return the value associated to the state, and whether the state
+   *       | has been inserted.
+   */
+  std::pair<int, bool> insert(const DFAState& state, int value);
+
+  /*!
+   * Find the value associated to the DFA state.
+   *
+   * @param state the DFA state.
+   * @return the value associated to the state, or -1 if it is not present.
+   */
+  int find(const DFAState& state) const;
+
+  /*!
+   * Get the identifier of an NFA state, registering it if needed.
+   *
+   * @param state the NFA state.
+   * @return the unique identifier of the NFA state.
+   */
+  size_t intern(const nfa_state_ptr& state);
+
+  size_t size() const { return entries_.size(); }
+  size_t nb_nfa_states() const { return nfa_states_.size(); }
+
+private:
+  struct Entry {
+    hash_t hash;
+    size_t key_begin;
+    size_t key_size;
+    int value;
+  };
+
+  std::vector<size_t> slots_;
+  std::vector<Entry> entries_;
+  std::vector<size_t> keys_;
+
+  std::vector<size_t> nfa_slots_;
+  std::vector<nfa_state_ptr> nfa_states_;
+
+  // reused buffer for the key of the DFA state being looked up.
+  mutable std::vector<size_t> key_buffer_;
+
+  bool make_key_(const DFAState& state) const;
+  size_t probe_(hash_t hash) const;
+  size_t probe_nfa_(const NFAState& state) const;
+  void rehash_();
+  void rehash_nfa_();
+};
+
+} // namespace whitemech::lydia
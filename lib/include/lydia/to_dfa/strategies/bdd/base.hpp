@@ -16,33 +16,80 @@
  * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <lydia/logic/atom_ordering.hpp>
 #include <lydia/to_dfa/core.hpp>
+#include <lydia/to_dfa/state_table.hpp>
 #include <lydia/to_dfa/strategies/bdd/delta_bdd.hpp>
 
 namespace whitemech::lydia {
 
+/*!
+ * The expansion of an NFA state, memoized during a translation.
+ *
+ * The finality is computed when the NFA state is first looked up, and
+ * the transitions only when they are needed.
+ */
+struct NFAStateExpansion {
+  NFAStateExpansion() = default;
+
+  bool initialized = false;
+  bool is_final = false;
+  bool expanded = false;
+  CUDD::BDD successor_fun;
+  std::map<nfa_state_ptr, CUDD::BDD, SharedComparator> transitions;
+};
+
 class BDDStrategy : public Strategy {
 private:
   AstManager* current_context_;
 
+  /*
+   * The NFA states are interned in the state table, and their expansion
+   * is stored at the index of their identifier. In this way, an NFA state
+   * shared among several DFA states is expanded exactly once. The table
+   * also interns the NFA states of the discovered DFA states, so the
+   * identifiers are not contiguous in the order of the lookups.
+   */
+  StateTable state_table_;
+  std::vector<NFAStateExpansion> expansions_;
+
+  const NFAStateExpansion& get_expansion_(const nfa_state_ptr& state,
+                                          bool expand);
+  bool is_final_(const DFAState& state);
+
 public:
   const CUDD::Cudd& mgr;
-  const size_t max_nb_bits;
+  const size_t initial_nb_bits;
   dfa_ptr automaton;
   std::vector<atom_ptr> id2atoms;
   std::map<atom_ptr, size_t, SharedComparator> atom2ids;
+  /*!
+   * The order of the atoms: the variable i of the automaton
+   * is the atom id2atoms[i].
+   */
+  std::shared_ptr<AtomOrdering> atom_ordering =
+      std::make_shared<LexicographicOrdering>();
 
   vec_bdd subformula_bddvars;
   std::vector<ldlf_ptr> id2subformula;
   std::map<ldlf_ptr, size_t, SharedComparator> subformula2id;
 
-  explicit BDDStrategy(const CUDD::Cudd& mgr, uint32_t max_nb_bits = 10)
-      : mgr{mgr}, max_nb_bits{max_nb_bits} {};
+  explicit BDDStrategy(const CUDD::Cudd& mgr, uint32_t initial_nb_bits = 1)
+      : mgr{mgr}, initial_nb_bits{initial_nb_bits} {};
 
   std::shared_ptr<abstract_dfa> to_dfa(const LDLfFormula& formula) override;
+  std::string signature() const override {
+    return "bdd;" + atom_ordering->signature();
+  }
+  std::shared_ptr<abstract_dfa> load(const MonaDFAFile& file) const override {
+    return std::make_shared<dfa>(mgr, file);
+  }
 
   std::map<nfa_state_ptr, CUDD::BDD, SharedComparator>
   next_transitions(const NFAState& state);
+  std::map<nfa_state_ptr, CUDD::BDD, SharedComparator>
+  next_transitions(const NFAState& state, const CUDD::BDD& successor_fun);
+  CUDD::BDD successor_function(const NFAState& state);
   std::vector<std::pair<dfa_state_ptr, CUDD::BDD>>
   next_transitions(const DFAState& state);
 
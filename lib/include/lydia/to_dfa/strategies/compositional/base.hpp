@@ -18,11 +18,14 @@
 
 #include <lydia/dfa/abstract_dfa.hpp>
 #include <lydia/dfa/mona_dfa.hpp>
+#include <lydia/logic/atom_ordering.hpp>
 #include <lydia/logic/atom_visitor.hpp>
 #include <lydia/logic/ldlf/only_test.hpp>
 #include <lydia/logic/nnf.hpp>
 #include <lydia/mona_ext/mona_ext_base.hpp>
 #include <lydia/to_dfa/core.hpp>
+#include <lydia/to_dfa/strategies/compositional/minimization.hpp>
+#include <lydia/to_dfa/strategies/compositional/templates.hpp>
 #include <numeric>
 #include <queue>
 
@@ -40,10 +43,80 @@ public:
   std::vector<atom_ptr> id2atoms;
   std::map<atom_ptr, size_t, SharedComparator> atom2ids;
   std::vector<int> indices;
+  /*!
+   * The order of the atoms, i.e. of the MONA variables.
+   * The names of the resulting automaton follow the same order.
+   */
+  std::shared_ptr<AtomOrdering> atom_ordering =
+      std::make_shared<LexicographicOrdering>();
+
+  /*!
+   * Whether the small operands of a conjunction/disjunction are
+   * combined with a single n-ary product, rather than pairwise.
+   */
+  bool use_nary_product = true;
+  /*! Operands with more states are left to the pairwise products. */
+  size_t nary_product_max_states = 16;
+  /*! Maximum number of operands of a single n-ary product. */
+  size_t nary_product_max_arity = 8;
+  /*! When the intermediate DFAs are minimized. */
+  MinimizationPolicy minimization;
+  /*!
+   * Whether to reuse the DFAs of the operands of conjunctions and
+   * disjunctions that are equal up to a renaming of the atoms.
+   */
+  bool use_templates = true;
+  /*! The templates of the current translation. */
+  TemplateCache templates;
+
   std::shared_ptr<abstract_dfa> to_dfa(const LDLfFormula& f) override;
+  /*!
+   * The result is always minimized, so only the atom ordering matters.
+   */
+  std::string signature() const override {
+    return "compositional;" + atom_ordering->signature();
+  }
   DFA* to_dfa_internal(const LDLfFormula& f, set_atoms_ptr atoms);
 
   DFA* star(const RegExp& r, DFA* body);
+
+  /*!
+   * Check the budget of the translation on an intermediate DFA.
+   *
+   * If the budget is exceeded, the DFA is freed before raising the error.
+   *
+   * @param automaton the intermediate DFA.
+   * @throw budget_exceeded_error if the budget is exceeded.
+   */
+  void check_budget(DFA* automaton);
+
+  /*!
+   * Minimize an intermediate DFA, according to the minimization policy.
+   *
+   * @param automaton the DFA. It is freed if a new DFA is returned.
+   * @param operand_nb_states the number of states of the largest operand.
+   * @return either the same DFA or its minimization.
+   */
+  DFA* minimize(DFA* automaton, size_t operand_nb_states) {
+    return minimization.minimize(automaton, operand_nb_states);
+  }
+
+  /*!
+   * Combine the small operands of a conjunction/disjunction
+   * with n-ary products.
+   *
+   * The operands with at most nary_product_max_states states are grouped
+   * in chunks of at most nary_product_max_arity DFAs, and every chunk
+   * is replaced by its minimized product. The DFAs of a chunk are freed.
+   * If a product is a sink, all the other DFAs are freed and the sink
+   * is the only element left.
+   *
+   * @param dfas the operands, updated in place.
+   * @param type either dfaAND or dfaOR.
+   * @param is_positive the kind of sink that makes the result trivial.
+   */
+  void combine_small_operands(std::vector<DFA*>& dfas, dfaProductType type,
+                              bool is_positive);
 };
 
 class AComposeDFAVisitor : public Visitor {
@@ -51,6 +124,21 @@ public:
   virtual DFA* apply(const LDLfFormula& f) { return nullptr; };
   virtual DFA* apply(const RegExp& f) { return nullptr; };
   virtual DFA* apply(const PropositionalFormula& f) { return nullptr; };
+  /*!
+   * Translate an operand of a conjunction or of a disjunction.
+   */
+  virtual DFA* apply_operand(const LDLfFormula& f) { return apply(f); };
+  virtual DFA* apply_operand(const PropositionalFormula& f) {
+    return apply(f);
+  };
+  virtual void check_budget(DFA* automaton){};
+  virtual DFA* minimize(DFA* automaton, size_t operand_nb_states) {
+    DFA* result = dfaMinimize(automaton);
+    dfaFree(automaton);
+    return result;
+  };
+  virtual void combine_small_operands(std::vector<DFA*>& dfas,
+                                      dfaProductType type, bool is_positive){};
 };
 
 class ComposeDFAVisitor : public AComposeDFAVisitor {
@@ -80,6 +168,19 @@ public:
   void visit(const LDLfT&) override{};
 
   DFA* apply(const LDLfFormula& f) override;
+  using AComposeDFAVisitor::apply_operand;
+  /*!
+   * Instantiate the DFA of the operand from its template, if any.
+   */
+  DFA* apply_operand(const LDLfFormula& f) override;
+  void check_budget(DFA* automaton) override { cs.check_budget(automaton); }
+  DFA* minimize(DFA* automaton, size_t operand_nb_states) override {
+    return cs.minimize(automaton, operand_nb_states);
+  }
+  void combine_small_operands(std::vector<DFA*>& dfas, dfaProductType type,
+                              bool is_positive) override {
+    cs.combine_small_operands(dfas, type, is_positive);
+  }
 };
 
 class ComposeDFARegexVisitor : public AComposeDFAVisitor {
@@ -116,6 +217,14 @@ public:
 
   DFA* apply(const RegExp& f) override;
   DFA* apply(const PropositionalFormula& f) override;
+  void check_budget(DFA* automaton) override { cs.check_budget(automaton); }
+  DFA* minimize(DFA* automaton, size_t operand_nb_states) override {
+    return cs.minimize(automaton, operand_nb_states);
+  }
+  void combine_small_operands(std::vector<DFA*>& dfas, dfaProductType type,
+                              bool is_positive) override {
+    cs.combine_small_operands(dfas, type, is_positive);
+  }
 };
 
 template <typename T, DFA* (*dfaMaker)(void), dfaProductType productType,
@@ -128,7 +237,14 @@ DFA* dfa_and_or(std::set<std::shared_ptr<T>, SharedComparator> container,
   auto dfas = std::vector<DFA*>();
   dfas.reserve(container.size());
   for (const auto& subf : container) {
-    tmp1 = v.apply(*subf);
+    try {
+      tmp1 = v.apply_operand(*subf);
+    } catch (...) {
+      for (const auto dfa_to_free : dfas) {
+        dfaFree(dfa_to_free);
+      }
+      throw;
+    }
     if (is_sink(tmp1, is_positive)) {
       for (const auto dfa_to_free : dfas) {
         dfaFree(dfa_to_free);
@@ -137,6 +253,7 @@ DFA* dfa_and_or(std::set<std::shared_ptr<T>, SharedComparator> container,
     }
     dfas.push_back(tmp1);
   }
+  v.combine_small_operands(dfas, productType, is_positive);
 
   auto cmp = [](const DFA* d1, const DFA* d2) { return d1->ns > d2->ns; };
   std::priority_queue<DFA*, std::vector<DFA*>, decltype(cmp)> queue(
@@ -147,10 +264,18 @@ DFA* dfa_and_or(std::set<std::shared_ptr<T>, SharedComparator> container,
     DFA* rhs = queue.top();
     queue.pop();
     tmp1 = dfaProduct(lhs, rhs, productType);
-    final = dfaMinimize(tmp1);
+    final = v.minimize(tmp1, std::max(lhs->ns, rhs->ns));
     dfaFree(lhs);
     dfaFree(rhs);
-    dfaFree(tmp1);
+    try {
+      v.check_budget(final);
+    } catch (...) {
+      while (!queue.empty()) {
+        dfaFree(queue.top());
+        queue.pop();
+      }
+      throw;
+    }
     if (is_sink(final, is_positive)) {
       while (!queue.empty()) {
         dfaFree(queue.top());
@@ -0,0 +1,83 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lydia/dfa/mona_dfa.hpp>
+#include <lydia/to_dfa/strategies/compositional/base.hpp>
+#include <memory>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * Build the DFA of a formula one operand at a time.
+ *
+ * The translator keeps the current minimized DFA and the table of the
+ * atoms seen so far. When a formula is conjoined (or disjoined), only
+ * the formula is translated, and it is combined with the current DFA
+ * with a single product.
+ *
+ * The atoms are numbered in lexicographic order, as with the default
+ * atom ordering of CompositionalStrategy, so the result is the same
+ * DFA as the translation of the whole formula. When new atoms appear,
+ * the indices of the current DFA are shifted with dfaReplaceIndices;
+ * since the old atoms keep their relative order, the remapping is
+ * monotone and the BDDs stay ordered.
+ */
+class IncrementalTranslator {
+private:
+  CompositionalStrategy& strategy_;
+  DFA* current_;
+  set_atoms_ptr atoms_;
+  std::vector<atom_ptr> id2atoms_;
+
+  void add_atoms_(const set_atoms_ptr& atoms);
+  void combine_(const LDLfFormula& formula, dfaProductType type,
+                bool is_positive);
+
+public:
+  /*!
+   * @param strategy the strategy used to translate the operands. Its
+   *      | options (minimization, templates...) are honored, but not
+   *      | its atom ordering.
+   * @param initial_value the initial DFA: true or false.
+   */
+  explicit IncrementalTranslator(CompositionalStrategy& strategy,
+                                 bool initial_value = true);
+  ~IncrementalTranslator();
+
+  IncrementalTranslator(const IncrementalTranslator&) = delete;
+  IncrementalTranslator& operator=(const IncrementalTranslator&) = delete;
+
+  void conjoin(const LDLfFormula& formula);
+  void disjoin(const LDLfFormula& formula);
+
+  /*!
+   * Forget the atoms, and set the DFA to true or false.
+   */
+  void reset(bool initial_value = true);
+
+  /*!
+   * @return a copy of the current DFA.
+   */
+  std::shared_ptr<mona_dfa> get_dfa() const;
+
+  const std::vector<atom_ptr>& get_atoms() const { return id2atoms_; }
+  int get_nb_states() const { return current_->ns; }
+};
+
+} // namespace whitemech::lydia
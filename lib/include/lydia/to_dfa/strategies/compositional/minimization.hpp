@@ -0,0 +1,94 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <lydia/mona_ext/mona_ext_base.hpp>
+
+namespace whitemech::lydia {
+
+enum class MinimizationMode { always, size_threshold, ratio, final_only };
+
+/*!
+ * Statistics collected by a MinimizationPolicy.
+ *
+ * The time saved is estimated from the average minimization time
+ * per state, multiplied by the number of states of the skipped DFAs.
+ */
+struct MinimizationStatistics {
+  size_t nb_requests = 0;
+  size_t nb_minimizations = 0;
+  size_t nb_skipped = 0;
+  size_t states_before = 0;
+  size_t states_pruned = 0;
+  size_t states_skipped = 0;
+  std::chrono::microseconds time_spent{0};
+
+  std::chrono::microseconds estimated_time_saved() const;
+};
+
+/*!
+ * Decide whether an intermediate DFA of the compositional
+ * construction has to be minimized.
+ *
+ * - always: minimize every intermediate DFA;
+ * - size_threshold: minimize only the DFAs with more than
+ *   size_threshold states;
+ * - ratio: minimize only the DFAs whose number of states is more than
+ *   ratio times the number of states of their largest operand;
+ * - final_only: minimize only the result of the translation.
+ */
+class MinimizationPolicy {
+public:
+  MinimizationMode mode = MinimizationMode::always;
+  size_t size_threshold = 64;
+  double ratio = 2.0;
+
+  MinimizationPolicy() = default;
+  explicit MinimizationPolicy(MinimizationMode mode) : mode{mode} {}
+
+  /*!
+   * Minimize an intermediate DFA, if the policy requires it.
+   *
+   * @param automaton the DFA. It is freed if a new DFA is returned.
+   * @param operand_nb_states the number of states of the largest operand
+   *       | the DFA has been built from.
+   * @return either the same DFA or its minimization.
+   */
+  DFA* minimize(DFA* automaton, size_t operand_nb_states);
+
+  /*!
+   * Minimize the result of the translation, unless the mode is
+   * 'always' (the result is already minimal).
+   *
+   * @param automaton the DFA. It is freed if a new DFA is returned.
+   * @return the minimized DFA.
+   */
+  DFA* finalize(DFA* automaton);
+
+  const MinimizationStatistics& get_statistics() const { return statistics_; }
+  void reset_statistics() { statistics_ = MinimizationStatistics(); }
+
+private:
+  MinimizationStatistics statistics_;
+
+  bool is_required_(const DFA* automaton, size_t operand_nb_states) const;
+  DFA* do_minimize_(DFA* automaton);
+};
+
+} // namespace whitemech::lydia
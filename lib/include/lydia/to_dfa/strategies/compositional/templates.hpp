@@ -0,0 +1,102 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lydia/logic/ldlf/base.hpp>
+#include <lydia/mona_ext/mona_ext_base.hpp>
+#include <lydia/types.hpp>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * The canonical form of a formula up to a renaming of its atoms.
+ *
+ * The atoms are replaced by placeholders, numbered by the rank of their
+ * identifiers. Two formulas with the same key are equal up to a renaming
+ * that preserves the order of the identifiers: the DFA of one of them is
+ * turned into the DFA of the other by a monotone remapping of the MONA
+ * indices, which keeps the BDDs ordered.
+ */
+struct FormulaTemplate {
+  std::string key;
+  /*! The identifiers of the atoms of the formula, in increasing order. */
+  std::vector<int> atom_ids;
+};
+
+/*!
+ * Compute the template of a formula.
+ *
+ * @param formula the formula.
+ * @param atom2ids the identifiers of the atoms.
+ * @return the template.
+ */
+FormulaTemplate
+make_template(const LDLfFormula& formula,
+              const std::map<atom_ptr, size_t, SharedComparator>& atom2ids);
+
+struct TemplateStatistics {
+  size_t nb_hits = 0;
+  size_t nb_misses = 0;
+};
+
+/*!
+ * The DFAs of the templates met during a translation.
+ *
+ * A DFA is stored with the placeholders as MONA indices, i.e. the atom
+ * with the i-th smallest identifier has index i, and it is instantiated
+ * with dfaReplaceIndices.
+ */
+class TemplateCache {
+private:
+  std::unordered_map<std::string, DFA*> templates_;
+  TemplateStatistics statistics_;
+
+public:
+  TemplateCache() = default;
+  TemplateCache(const TemplateCache&) = delete;
+  TemplateCache& operator=(const TemplateCache&) = delete;
+  ~TemplateCache() { clear(); }
+
+  /*!
+   * Instantiate the DFA of a template.
+   *
+   * @param t the template, with the identifiers of the instance.
+   * @return the DFA of the instance, or nullptr if the template is
+   *       | not in the cache. The caller owns the DFA.
+   */
+  DFA* instantiate(const FormulaTemplate& t);
+
+  /*!
+   * Store the DFA of an instance of a template.
+   *
+   * @param t the template, with the identifiers of the instance.
+   * @param automaton the DFA of the instance. It is copied.
+   */
+  void insert(const FormulaTemplate& t, DFA* automaton);
+
+  void clear();
+  size_t size() const { return templates_.size(); }
+
+  const TemplateStatistics& get_statistics() const { return statistics_; }
+  void reset_statistics() { statistics_ = TemplateStatistics(); }
+};
+
+} // namespace whitemech::lydia
@@ -32,13 +32,27 @@ class NaiveStrategy : public Strategy {
 private:
   AstManager* current_context;
   const CUDD::Cudd& mgr;
-  const size_t max_nb_bits;
+  const size_t initial_nb_bits;
+  const bool gray_code_sweep;
 
 public:
-  explicit NaiveStrategy(const CUDD::Cudd& mgr, uint32_t max_nb_bits = 10)
-      : mgr{mgr}, max_nb_bits{max_nb_bits} {};
+  /*!
+   * @param mgr the CUDD manager.
+   * @param initial_nb_bits the initial number of bits of the DFA.
+   * @param gray_code_sweep whether to compute the successors with
+   *      | NaiveStrategy::next_transitions, rather than computing the
+   *      | successor of every interpretation from scratch.
+   */
+  explicit NaiveStrategy(const CUDD::Cudd& mgr, uint32_t initial_nb_bits = 1,
+                         bool gray_code_sweep = false)
+      : mgr{mgr}, initial_nb_bits{initial_nb_bits},
+        gray_code_sweep{gray_code_sweep} {};
 
   std::shared_ptr<abstract_dfa> to_dfa(const LDLfFormula& formula) override;
+  std::string signature() const override { return "naive"; }
+  std::shared_ptr<abstract_dfa> load(const MonaDFAFile& file) const override {
+    return std::make_shared<dfa>(mgr, file);
+  }
 
   /*!
    * Compute the next state, given a propositional interpretation.
@@ -63,6 +77,24 @@ public:
    */
   static set_nfa_states next_states(const NFAState& state,
                                     const set_atoms_ptr& i);
+
+  /*!
+   * Compute all the successors of a DFA state, each with its guard.
+   *
+   * The interpretations are visited in Gray-code order, so that two
+   * consecutive interpretations differ by exactly one atom. The successors
+   * of an NFA state are recomputed only when the flipped atom occurs
+   * in one of its formulas. The interpretations that lead to the same
+   * DFA state are grouped in one guard.
+   *
+   * @param state the current DFA state.
+   * @param atoms the atoms, in the order of the variables of the DFA.
+   * @param automaton the DFA the guards are built for.
+   * @return the pairs (successor DFA state, guard).
+   */
+  static std::vector<std::pair<dfa_state_ptr, CUDD::BDD>>
+  next_transitions(const DFAState& state, const std::vector<atom_ptr>& atoms,
+                   const dfa& automaton);
 };
 
 } // namespace whitemech::lydia
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lydia/dfa/mona_dfa.hpp>
+#include <lydia/logger.hpp>
+#include <lydia/to_dfa/core.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * A strategy that races several strategies on the same formula.
+ *
+ * Each strategy runs in a separate (forked) process, since neither
+ * MONA nor the AST manager are thread-safe. The first process that
+ * terminates successfully wins: its DFA is exported to a temporary file
+ * in the MONA format, and the other processes are killed.
+ *
+ * The result is always a mona_dfa. If the winner produced another kind
+ * of DFA, it is converted with dfa_from_abstract_dfa, which enumerates
+ * all the interpretations.
+ */
+class PortfolioStrategy : public Strategy {
+private:
+  static Logger logger;
+  std::vector<std::pair<std::string, std::shared_ptr<Strategy>>> strategies_;
+  std::string winner_;
+
+public:
+  /*!
+   * @param strategies the named strategies to race.
+   */
+  explicit PortfolioStrategy(
+      std::vector<std::pair<std::string, std::shared_ptr<Strategy>>>
+          strategies);
+
+  std::shared_ptr<abstract_dfa> to_dfa(const LDLfFormula& f) override;
+
+  /*!
+   * @return the signatures of all the strategies, or the empty string
+   *       | if one of them has no signature.
+   */
+  std::string signature() const override;
+
+  /*!
+   * @return the name of the strategy that won the last translation.
+   */
+  const std::string& get_winner() const { return winner_; }
+};
+
+} // namespace whitemech::lydia
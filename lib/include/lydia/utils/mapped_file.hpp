@@ -0,0 +1,49 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <string>
+
+namespace whitemech::lydia {
+
+/*!
+ * A read-only memory mapping of a whole file.
+ */
+class MappedFile {
+private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+
+public:
+  /*!
+   * @param filename path to the file.
+   * @throw std::runtime_error if the file does not exist, is empty
+   *      | or cannot be mapped.
+   */
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* begin() const { return static_cast<const char*>(data_); }
+  const char* end() const { return begin() + size_; }
+  size_t size() const { return size_; }
+};
+
+} // namespace whitemech::lydia
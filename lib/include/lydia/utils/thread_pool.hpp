@@ -0,0 +1,85 @@
+#pragma once
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace whitemech::lydia {
+
+/*!
+ * A fixed set of worker threads that run parallel loops.
+ *
+ * The calling thread takes part in the loop, so a pool of n threads
+ * spawns n - 1 workers. Only one loop runs at a time.
+ */
+class ThreadPool {
+public:
+  using body_t = std::function<void(size_t, size_t)>;
+
+private:
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::mutex loop_mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable work_done_;
+  bool stop_ = false;
+  uint64_t generation_ = 0;
+  size_t nb_busy_ = 0;
+
+  // the current loop. They are changed only when no worker is busy.
+  const body_t* body_ = nullptr;
+  size_t nb_items_ = 0;
+  size_t chunk_size_ = 1;
+  std::atomic<size_t> next_chunk_{0};
+  std::exception_ptr error_;
+
+  void worker_loop_();
+  void run_chunks_(const body_t* body, size_t nb_items, size_t chunk_size);
+
+public:
+  /*!
+   * @param nb_threads the number of threads, including the calling
+   *      | thread. If 0, the number of hardware threads is used.
+   */
+  explicit ThreadPool(size_t nb_threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t get_nb_threads() const { return workers_.size() + 1; }
+
+  /*!
+   * Split [0, nb_items) in chunks of (at most) chunk_size items, and
+   * call body(begin, end) on every chunk, in parallel. Return when all
+   * the chunks have been processed.
+   *
+   * If body throws, the first exception is rethrown to the caller, once
+   * the other chunks have been processed.
+   */
+  void parallel_for(size_t nb_items, size_t chunk_size, const body_t& body);
+};
+
+} // namespace whitemech::lydia
@@ -0,0 +1,201 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <lydia/dfa/batch.hpp>
+#include <lydia/dfa/compiled_dfa.hpp>
+#include <lydia/dfa/compressed_dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <stdexcept>
+
+namespace whitemech::lydia {
+
+// multiple of 64, so that every chunk writes whole words of the bitmap.
+static const size_t TRACES_PER_CHUNK = 1024;
+
+TraceBuffer::TraceBuffer(int nb_variables)
+    : nb_variables_{nb_variables},
+      words_per_symbol_{std::max<size_t>((nb_variables + 63) / 64, 1)},
+      offsets_{0} {}
+
+TraceBuffer::TraceBuffer(int nb_variables, std::vector<uint64_t> data,
+                         std::vector<size_t> offsets)
+    : TraceBuffer(nb_variables) {
+  if (offsets.empty() || offsets.front() != 0)
+    throw std::invalid_argument("the offsets must start with 0");
+  for (size_t t = 1; t < offsets.size(); t++)
+    if (offsets[t] < offsets[t - 1])
+      throw std::invalid_argument("the offsets must be non-decreasing");
+  if (offsets.back() * words_per_symbol_ != data.size())
+    throw std::invalid_argument("the data does not match the offsets");
+  data_ = std::move(data);
+  offsets_ = std::move(offsets);
+}
+
+void TraceBuffer::add_trace(const trace& word) {
+  for (const auto& symbol : word) {
+    size_t begin = data_.size();
+    data_.resize(begin + words_per_symbol_, 0);
+    for (int i = 0; i < nb_variables_ && i < (int)symbol.size(); i++)
+      if (symbol[i])
+        data_[begin + (i >> 6)] |= uint64_t(1) << (i & 63);
+  }
+  offsets_.push_back(offsets_.back() + word.size());
+}
+
+void TraceBuffer::add_trace(const trace_bits& word) {
+  for (const auto& symbol : word) {
+    size_t begin = data_.size();
+    data_.resize(begin + words_per_symbol_, 0);
+    size_t nb_words = std::min(words_per_symbol_, symbol.get_nb_words());
+    std::copy(symbol.data(), symbol.data() + nb_words, data_.begin() + begin);
+    // drop the variables beyond the ones of the buffer.
+    if (nb_words == words_per_symbol_ &&
+        (size_t)nb_variables_ < 64 * words_per_symbol_)
+      data_.back() &= (uint64_t(1) << (nb_variables_ % 64)) - 1;
+  }
+  offsets_.push_back(offsets_.back() + word.size());
+}
+
+void TraceBuffer::clear() {
+  data_.clear();
+  offsets_.assign(1, 0);
+}
+
+size_t VerdictBitmap::count() const {
+  size_t result = 0;
+  for (auto word : words_)
+    result += __builtin_popcountll(word);
+  return result;
+}
+
+static void accepts_mona(const mona_dfa& automaton, const TraceBuffer& traces,
+                         const StateClassification* classification,
+                         size_t begin, size_t end, VerdictBitmap& result) {
+  const DFA* a = automaton.dfa_;
+  const bdd_record* node_table = a->bddm->node_table;
+  for (size_t t = begin; t < end; t++) {
+    int state = a->s;
+    for (size_t k = traces.get_trace_begin(t); k < traces.get_trace_end(t);
+         k++) {
+      if (classification != nullptr && !classification->is_live(state))
+        break;
+      const uint64_t* bits = traces.get_symbol(k);
+      unsigned l, r, index;
+      LOAD_lri(&node_table[a->q[state]], l, r, index);
+      while (index != BDD_LEAF_INDEX) {
+        unsigned next = ((bits[index >> 6] >> (index & 63)) & 1) ? r : l;
+        LOAD_lri(&node_table[next], l, r, index);
+      }
+      state = l;
+    }
+    if (a->f[state] == 1)
+      result.set(t);
+  }
+}
+
+static void accepts_compiled(const compiled_dfa& automaton,
+                             const TraceBuffer& traces,
+                             const StateClassification* classification,
+                             size_t begin, size_t end, VerdictBitmap& result) {
+  const uint64_t mask = (uint64_t(1) << automaton.get_nb_variables()) - 1;
+  for (size_t t = begin; t < end; t++) {
+    int state = automaton.get_initial_state();
+    for (size_t k = traces.get_trace_begin(t); k < traces.get_trace_end(t);
+         k++) {
+      if (classification != nullptr && !classification->is_live(state))
+        break;
+      state = automaton.get_successor(state, traces.get_symbol(k)[0] & mask);
+    }
+    if (automaton.is_final(state))
+      result.set(t);
+  }
+}
+
+static void accepts_compressed(const compressed_dfa& automaton,
+                               const TraceBuffer& traces,
+                               const StateClassification* classification,
+                               size_t begin, size_t end,
+                               VerdictBitmap& result) {
+  const auto& classifier = automaton.get_classifier();
+  for (size_t t = begin; t < end; t++) {
+    int state = automaton.get_initial_state();
+    for (size_t k = traces.get_trace_begin(t); k < traces.get_trace_end(t);
+         k++) {
+      if (classification != nullptr && !classification->is_live(state))
+        break;
+      int symbol_class = classifier.classify(traces.get_symbol(k));
+      state = automaton.get_class_successor(state, symbol_class);
+    }
+    if (automaton.is_final(state))
+      result.set(t);
+  }
+}
+
+static void accepts_generic(const abstract_dfa& automaton,
+                            const TraceBuffer& traces,
+                            const StateClassification* classification,
+                            VerdictBitmap& result) {
+  const int nb_variables = automaton.get_nb_variables();
+  interpretation symbol(nb_variables);
+  for (size_t t = 0; t < traces.get_nb_traces(); t++) {
+    int state = automaton.get_initial_state();
+    for (size_t k = traces.get_trace_begin(t); k < traces.get_trace_end(t);
+         k++) {
+      if (classification != nullptr && !classification->is_live(state))
+        break;
+      for (int i = 0; i < nb_variables; i++)
+        symbol[i] = traces.get_value(k, i);
+      state = automaton.get_successor(state, symbol);
+    }
+    if (automaton.is_final(state))
+      result.set(t);
+  }
+}
+
+VerdictBitmap accepts_many(const abstract_dfa& automaton,
+                           const TraceBuffer& traces, ThreadPool* pool,
+                           const StateClassification* classification) {
+  if (traces.get_nb_variables() < automaton.get_nb_variables())
+    throw std::invalid_argument("the traces have too few variables");
+  auto result = VerdictBitmap(traces.get_nb_traces());
+  ThreadPool::body_t body;
+  if (const auto* mona = dynamic_cast<const mona_dfa*>(&automaton)) {
+    body = [&, mona](size_t begin, size_t end) {
+      accepts_mona(*mona, traces, classification, begin, end, result);
+    };
+  } else if (const auto* compiled =
+                 dynamic_cast<const compiled_dfa*>(&automaton)) {
+    body = [&, compiled](size_t begin, size_t end) {
+      accepts_compiled(*compiled, traces, classification, begin, end, result);
+    };
+  } else if (const auto* compressed =
+                 dynamic_cast<const compressed_dfa*>(&automaton)) {
+    body = [&, compressed](size_t begin, size_t end) {
+      accepts_compressed(*compressed, traces, classification, begin, end,
+                         result);
+    };
+  } else {
+    accepts_generic(automaton, traces, classification, result);
+    return result;
+  }
+  if (pool == nullptr)
+    body(0, traces.get_nb_traces());
+  else
+    pool->parallel_for(traces.get_nb_traces(), TRACES_PER_CHUNK, body);
+  return result;
+}
+
+} // namespace whitemech::lydia
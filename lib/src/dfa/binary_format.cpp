@@ -0,0 +1,352 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <lydia/dfa/binary_format.hpp>
+#include <lydia/dfa/dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <lydia/dfa/successor_bits.hpp>
+#include <lydia/utils/mapped_file.hpp>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace whitemech::lydia {
+
+static const char BINARY_DFA_MAGIC[] = {'L', 'Y', 'D', 'I', 'A', 'D', 'F', 'A'};
+static const std::int32_t END_OF_NODES = -2;
+
+#define NODE_NOT_MADE (bdd_ptr)-1
+
+void BinaryDFAWriter::write_int(std::int32_t value) {
+  auto u = static_cast<std::uint32_t>(value);
+  char bytes[4] = {static_cast<char>(u & 0xFF),
+                   static_cast<char>((u >> 8) & 0xFF),
+                   static_cast<char>((u >> 16) & 0xFF),
+                   static_cast<char>((u >> 24) & 0xFF)};
+  out_.write(bytes, 4);
+}
+
+void BinaryDFAWriter::write_header(const std::vector<std::string>& variables) {
+  out_.write(BINARY_DFA_MAGIC, sizeof(BINARY_DFA_MAGIC));
+  write_int(BINARY_DFA_VERSION);
+  write_int(variables.size());
+  for (const auto& name : variables) {
+    write_int(name.size());
+    out_.write(name.data(), name.size());
+  }
+}
+
+int BinaryDFAWriter::write_leaf(int value) {
+  assert(!nodes_closed_);
+  write_int(-1);
+  write_int(value);
+  write_int(0);
+  return nb_nodes_++;
+}
+
+int BinaryDFAWriter::write_node(int position, int low, int high) {
+  assert(!nodes_closed_);
+  assert(low < nb_nodes_ && high < nb_nodes_);
+  write_int(position);
+  write_int(low);
+  write_int(high);
+  return nb_nodes_++;
+}
+
+void BinaryDFAWriter::write_states(int initial_state,
+                                   const std::vector<int>& roots,
+                                   const std::vector<bool>& finals) {
+  assert(roots.size() == finals.size());
+  write_int(END_OF_NODES);
+  write_int(0);
+  write_int(0);
+  nodes_closed_ = true;
+  write_int(roots.size());
+  write_int(initial_state);
+  for (int root : roots)
+    write_int(root);
+  std::vector<char> bitmap((finals.size() + 7) / 8, 0);
+  for (size_t i = 0; i < finals.size(); i++)
+    if (finals[i])
+      bitmap[i / 8] |= static_cast<char>(1 << (i % 8));
+  out_.write(bitmap.data(), bitmap.size());
+  if (!out_)
+    throw std::runtime_error("Cannot write the binary DFA.");
+}
+
+void write_binary_dfa(std::ostream& out, const MonaDFAFile& content) {
+  BinaryDFAWriter writer(out);
+  writer.write_header(content.variables);
+  // the nodes of a MONA file are not sorted: renumber them in post-order.
+  const auto& nodes = content.bdd_nodes;
+  std::vector<int> ids(content.get_nb_nodes(), -1);
+  std::function<int(int)> visit = [&](int node) -> int {
+    if (ids[node] != -1)
+      return ids[node];
+    int x = nodes[3 * node];
+    if (x == -1)
+      ids[node] = writer.write_leaf(nodes[3 * node + 1]);
+    else {
+      int low = visit(nodes[3 * node + 1]);
+      int high = visit(nodes[3 * node + 2]);
+      ids[node] = writer.write_node(x, low, high);
+    }
+    return ids[node];
+  };
+  std::vector<int> roots;
+  roots.reserve(content.nb_states);
+  for (int root : content.behaviour)
+    roots.push_back(visit(root));
+  std::vector<bool> finals(content.nb_states, false);
+  for (int state : content.final_states)
+    finals[state] = true;
+  writer.write_states(content.initial_state, roots, finals);
+}
+
+void write_binary_dfa(std::ostream& out, const mona_dfa& automaton) {
+  const DFA* a = automaton.dfa_;
+  bdd_manager* bddm = a->bddm;
+  std::unordered_map<unsigned, int> index2position;
+  for (int i = 0; i < automaton.get_nb_variables(); i++)
+    index2position[automaton.indices[i]] = i;
+
+  BinaryDFAWriter writer(out);
+  writer.write_header(automaton.names);
+  std::unordered_map<bdd_ptr, int> node2id;
+  std::function<int(bdd_ptr)> visit = [&](bdd_ptr p) -> int {
+    auto it = node2id.find(p);
+    if (it != node2id.end())
+      return it->second;
+    unsigned l, r, index;
+    LOAD_lri(&bddm->node_table[p], l, r, index);
+    int id;
+    if (index == BDD_LEAF_INDEX)
+      id = writer.write_leaf(l);
+    else {
+      int low = visit(l);
+      int high = visit(r);
+      id = writer.write_node(index2position.at(index), low, high);
+    }
+    node2id[p] = id;
+    return id;
+  };
+
+  std::vector<int> roots(a->ns);
+  std::vector<bool> finals(a->ns);
+  for (int j = 0; j < a->ns; j++) {
+    roots[j] = visit(a->q[j]);
+    finals[j] = a->f[j] == 1;
+  }
+  writer.write_states(a->s, roots, finals);
+}
+
+void write_binary_dfa(std::ostream& out, const dfa& automaton) {
+  const int nb_variables = automaton.get_nb_variables();
+
+  // the DFAs built from scratch have no names: use the positions.
+  auto names = automaton.variables;
+  if ((int)names.size() != nb_variables) {
+    names.clear();
+    for (int i = 0; i < nb_variables; i++)
+      names.push_back(std::to_string(i));
+  }
+
+  BinaryDFAWriter writer(out);
+  writer.write_header(names);
+  auto walker = SuccessorBitsWalker(
+      automaton,
+      [&](const std::vector<int>& successors, const interpretation&) {
+        return writer.write_leaf(successors[0]);
+      },
+      [&](int position, int low_id, int high_id) {
+        return writer.write_node(position, low_id, high_id);
+      });
+
+  const int nb_states = automaton.get_nb_states();
+  std::vector<int> roots(nb_states);
+  std::vector<bool> finals(nb_states);
+  for (int j = 0; j < nb_states; j++) {
+    roots[j] = walker.walk(automaton.get_successor_bits(j));
+    finals[j] = automaton.is_final(j);
+  }
+  writer.write_states(automaton.get_initial_state(), roots, finals);
+}
+
+template <typename Automaton>
+static void write_to_file(const std::string& filename,
+                          const Automaton& automaton) {
+  std::ofstream out(filename, std::ios::binary);
+  if (!out)
+    throw std::runtime_error("Cannot open file: " + filename);
+  write_binary_dfa(out, automaton);
+}
+
+void write_binary_dfa_file(const std::string& filename,
+                           const mona_dfa& automaton) {
+  write_to_file(filename, automaton);
+}
+
+void write_binary_dfa_file(const std::string& filename,
+                           const dfa& automaton) {
+  write_to_file(filename, automaton);
+}
+
+/*
+ * A cursor over the buffer of a binary DFA.
+ */
+class BinaryDFAReader {
+private:
+  const char* current_;
+  const char* const end_;
+
+public:
+  BinaryDFAReader(const char* begin, const char* end)
+      : current_{begin}, end_{end} {}
+
+  [[noreturn]] static void fail(const std::string& message) {
+    throw std::runtime_error("Malformed binary DFA: " + message);
+  }
+
+  const char* next_bytes(size_t length) {
+    if ((size_t)(end_ - current_) < length)
+      fail("unexpected end of file");
+    const char* result = current_;
+    current_ += length;
+    return result;
+  }
+
+  std::int32_t next_int() {
+    auto bytes = reinterpret_cast<const unsigned char*>(next_bytes(4));
+    std::uint32_t u = (std::uint32_t)bytes[0] |
+                      ((std::uint32_t)bytes[1] << 8) |
+                      ((std::uint32_t)bytes[2] << 16) |
+                      ((std::uint32_t)bytes[3] << 24);
+    return static_cast<std::int32_t>(u);
+  }
+
+  int next_count() {
+    std::int32_t value = next_int();
+    if (value < 0)
+      fail("negative size");
+    return value;
+  }
+
+  bool at_end() const { return current_ == end_; }
+};
+
+MonaDFAFile parse_binary_dfa(const char* begin, const char* end) {
+  BinaryDFAReader reader(begin, end);
+  if (std::memcmp(reader.next_bytes(sizeof(BINARY_DFA_MAGIC)),
+                  BINARY_DFA_MAGIC, sizeof(BINARY_DFA_MAGIC)) != 0)
+    reader.fail("bad magic number");
+  auto version = static_cast<std::uint32_t>(reader.next_int());
+  if (version != BINARY_DFA_VERSION)
+    throw std::runtime_error("Unsupported binary DFA version: " +
+                             std::to_string(version));
+
+  MonaDFAFile result;
+  int nb_variables = reader.next_count();
+  result.variables.reserve(nb_variables);
+  for (int i = 0; i < nb_variables; i++) {
+    int length = reader.next_count();
+    result.variables.emplace_back(reader.next_bytes(length), length);
+  }
+
+  // the successors precede a node, so the references are checked on the fly.
+  for (int id = 0;; id++) {
+    std::int32_t x = reader.next_int();
+    std::int32_t l = reader.next_int();
+    std::int32_t r = reader.next_int();
+    if (x == END_OF_NODES)
+      break;
+    if (x < -1 || x >= nb_variables)
+      reader.fail("bad variable position");
+    if (x != -1 && (l < 0 || l >= id || r < 0 || r >= id))
+      reader.fail("bad node reference");
+    result.bdd_nodes.push_back(x);
+    result.bdd_nodes.push_back(l);
+    result.bdd_nodes.push_back(r);
+  }
+
+  result.nb_states = reader.next_count();
+  result.initial_state = reader.next_int();
+  if (result.initial_state < 0 || result.initial_state >= result.nb_states)
+    reader.fail("bad initial state");
+  int nb_nodes = result.get_nb_nodes();
+  result.behaviour.reserve(result.nb_states);
+  for (int j = 0; j < result.nb_states; j++) {
+    int root = reader.next_int();
+    if (root < 0 || root >= nb_nodes)
+      reader.fail("bad state root");
+    result.behaviour.push_back(root);
+  }
+  for (int id = 0; id < nb_nodes; id++) {
+    int x = result.bdd_nodes[3 * id];
+    int value = result.bdd_nodes[3 * id + 1];
+    if (x == -1 && (value < 0 || value >= result.nb_states))
+      reader.fail("bad successor state");
+  }
+  auto bitmap = reinterpret_cast<const unsigned char*>(
+      reader.next_bytes((result.nb_states + 7) / 8));
+  for (int j = 0; j < result.nb_states; j++)
+    if (bitmap[j / 8] & (1 << (j % 8)))
+      result.final_states.push_back(j);
+  if (!reader.at_end())
+    reader.fail("trailing data");
+  return result;
+}
+
+MonaDFAFile parse_binary_dfa_file(const std::string& filename) {
+  MappedFile file(filename);
+  return parse_binary_dfa(file.begin(), file.end());
+}
+
+DFA* mona_dfa_from_file(const MonaDFAFile& file) {
+  const auto& nodes = file.bdd_nodes;
+  int nb_nodes = file.get_nb_nodes();
+  DFA* res = dfaMakeNoBddm(file.nb_states);
+  res->bddm = bdd_new_manager(8 * nb_nodes + 8, ((nb_nodes + 3) / 4) * 4);
+  res->s = file.initial_state;
+
+  // as in MONA's dfaImport, the nodes are created on demand.
+  std::vector<bdd_ptr> ptrs(nb_nodes, NODE_NOT_MADE);
+  std::function<bdd_ptr(int)> make_node = [&](int node) -> bdd_ptr {
+    if (ptrs[node] != NODE_NOT_MADE)
+      return ptrs[node];
+    int x = nodes[3 * node];
+    if (x == -1)
+      ptrs[node] = bdd_find_leaf_sequential(res->bddm, nodes[3 * node + 1]);
+    else {
+      bdd_ptr l = make_node(nodes[3 * node + 1]);
+      bdd_ptr r = make_node(nodes[3 * node + 2]);
+      ptrs[node] = bdd_find_node_sequential(res->bddm, l, r, x);
+    }
+    return ptrs[node];
+  };
+
+  for (int j = 0; j < file.nb_states; j++) {
+    res->q[j] = make_node(file.behaviour[j]);
+    res->f[j] = -1;
+  }
+  for (int state : file.final_states)
+    res->f[state] = 1;
+  return res;
+}
+
+} // namespace whitemech::lydia
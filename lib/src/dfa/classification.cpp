@@ -0,0 +1,144 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cassert>
+#include <lydia/dfa/classification.hpp>
+#include <lydia/dfa/successor_bits.hpp>
+#include <unordered_set>
+
+namespace whitemech::lydia {
+
+/*
+ * Mark the states that can reach a state in the target set, by a
+ * backward visit from the targets. The predecessors are stored in
+ * compressed sparse row format.
+ */
+static std::vector<bool> can_reach(const std::vector<int>& offsets,
+                                   const std::vector<int>& predecessors,
+                                   const std::vector<bool>& finals,
+                                   bool target) {
+  const int nb_states = finals.size();
+  std::vector<bool> result(nb_states, false);
+  std::vector<int> stack;
+  for (int s = 0; s < nb_states; s++) {
+    if (finals[s] == target) {
+      result[s] = true;
+      stack.push_back(s);
+    }
+  }
+  while (!stack.empty()) {
+    int s = stack.back();
+    stack.pop_back();
+    for (int k = offsets[s]; k < offsets[s + 1]; k++) {
+      int p = predecessors[k];
+      if (!result[p]) {
+        result[p] = true;
+        stack.push_back(p);
+      }
+    }
+  }
+  return result;
+}
+
+StateClassification
+classify_states(const std::vector<std::vector<int>>& successors,
+                const std::vector<bool>& finals) {
+  const int nb_states = finals.size();
+  assert(successors.size() == finals.size());
+  std::vector<int> offsets(nb_states + 1, 0);
+  for (const auto& succ : successors)
+    for (int t : succ)
+      ++offsets[t + 1];
+  for (int s = 0; s < nb_states; s++)
+    offsets[s + 1] += offsets[s];
+  std::vector<int> predecessors(offsets[nb_states]);
+  std::vector<int> next(offsets.begin(), offsets.end() - 1);
+  for (int s = 0; s < nb_states; s++)
+    for (int t : successors[s])
+      predecessors[next[t]++] = s;
+
+  auto reach_final = can_reach(offsets, predecessors, finals, true);
+  auto reach_non_final = can_reach(offsets, predecessors, finals, false);
+  std::vector<StateClass> classes(nb_states, StateClass::live);
+  for (int s = 0; s < nb_states; s++) {
+    if (!reach_non_final[s])
+      classes[s] = StateClass::accepting_sink;
+    else if (!reach_final[s])
+      classes[s] = StateClass::rejecting_sink;
+  }
+  return StateClassification(std::move(classes));
+}
+
+StateClassification classify_states(const mona_dfa& automaton) {
+  const DFA* a = automaton.dfa_;
+  bdd_manager* bddm = a->bddm;
+  std::vector<std::vector<int>> successors(a->ns);
+  std::vector<bool> finals(a->ns);
+  std::unordered_set<bdd_ptr> visited;
+  std::vector<bdd_ptr> stack;
+  for (int s = 0; s < a->ns; s++) {
+    finals[s] = a->f[s] == 1;
+    visited.clear();
+    stack.push_back(a->q[s]);
+    while (!stack.empty()) {
+      bdd_ptr p = stack.back();
+      stack.pop_back();
+      if (!visited.insert(p).second)
+        continue;
+      unsigned l, r, index;
+      LOAD_lri(&bddm->node_table[p], l, r, index);
+      if (index == BDD_LEAF_INDEX) {
+        successors[s].push_back(l);
+      } else {
+        stack.push_back(l);
+        stack.push_back(r);
+      }
+    }
+  }
+  return classify_states(successors, finals);
+}
+
+StateClassification classify_states(const dfa& automaton) {
+  const int nb_states = automaton.get_nb_states();
+  std::vector<std::vector<int>> successors(nb_states);
+  std::vector<bool> finals(nb_states);
+  for (int s = 0; s < nb_states; s++) {
+    finals[s] = automaton.is_final(s);
+    // a fresh walker per state, so that every leaf is reached once.
+    auto walker = SuccessorBitsWalker(
+        automaton,
+        [&](const std::vector<int>& leaf, const interpretation&) {
+          successors[s].push_back(leaf[0]);
+          return 0;
+        },
+        [](int, int, int) { return 0; });
+    walker.walk(automaton.get_successor_bits(s));
+  }
+  return classify_states(successors, finals);
+}
+
+bool accepts(const abstract_dfa& automaton,
+             const StateClassification& classification, const trace& word) {
+  int current_state = automaton.get_initial_state();
+  for (const auto& symbol : word) {
+    if (!classification.is_live(current_state))
+      break;
+    current_state = automaton.get_successor(current_state, symbol);
+  }
+  return automaton.is_final(current_state);
+}
+
+} // namespace whitemech::lydia
@@ -0,0 +1,146 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cassert>
+#include <limits>
+#include <lydia/dfa/compiled_dfa.hpp>
+#include <stdexcept>
+
+namespace whitemech::lydia {
+
+static void check_nb_variables(int nb_variables) {
+  if (nb_variables > compiled_dfa::MAX_NB_VARIABLES)
+    throw std::invalid_argument(
+        "too many variables for a compiled DFA: " +
+        std::to_string(nb_variables) + " (at most " +
+        std::to_string(compiled_dfa::MAX_NB_VARIABLES) + ")");
+}
+
+void compiled_dfa::allocate_() {
+  size_t size = (size_t)nb_states_ << nb_variables_;
+  if (nb_states_ <= std::numeric_limits<uint16_t>::max() + 1)
+    table16_.assign(size, 0);
+  else
+    table32_.assign(size, 0);
+}
+
+void compiled_dfa::set_successor_(int state, uint32_t symbol,
+                                  int successor) {
+  size_t i = ((size_t)state << nb_variables_) | symbol;
+  if (table16_.empty())
+    table32_[i] = successor;
+  else
+    table16_[i] = successor;
+}
+
+/*
+ * Fill the entries of the interpretations that agree with the symbol on
+ * the variables before the position. The variables that the node does
+ * not test take both values.
+ */
+void compiled_dfa::fill_mona_(const mona_dfa& automaton, unsigned node,
+                              int state, uint32_t symbol, int position) {
+  unsigned l, r, index;
+  LOAD_lri(&automaton.dfa_->bddm->node_table[node], l, r, index);
+  if (index == BDD_LEAF_INDEX && position == nb_variables_) {
+    set_successor_(state, symbol, l);
+    return;
+  }
+  if (index != BDD_LEAF_INDEX && (int)index == position) {
+    fill_mona_(automaton, l, state, symbol, position + 1);
+    fill_mona_(automaton, r, state, symbol | (1u << position), position + 1);
+    return;
+  }
+  assert(position < nb_variables_);
+  fill_mona_(automaton, node, state, symbol, position + 1);
+  fill_mona_(automaton, node, state, symbol | (1u << position), position + 1);
+}
+
+compiled_dfa::compiled_dfa(const abstract_dfa& automaton)
+    : nb_variables_{automaton.get_nb_variables()},
+      nb_states_{automaton.get_nb_states()},
+      initial_state_{automaton.get_initial_state()} {
+  check_nb_variables(nb_variables_);
+  allocate_();
+  finals_.resize(nb_states_);
+  for (int s = 0; s < nb_states_; s++)
+    finals_[s] = automaton.is_final(s);
+
+  const auto* mona = dynamic_cast<const mona_dfa*>(&automaton);
+  if (mona != nullptr) {
+    for (int s = 0; s < nb_states_; s++)
+      fill_mona_(*mona, mona->dfa_->q[s], s, 0, 0);
+    return;
+  }
+  auto symbol = interpretation_bits(nb_variables_);
+  for (int s = 0; s < nb_states_; s++) {
+    for (uint32_t code = 0; code < (1u << nb_variables_); code++) {
+      for (int i = 0; i < nb_variables_; i++)
+        symbol.set(i, (code >> i) & 1);
+      set_successor_(s, code, automaton.get_successor(s, symbol));
+    }
+  }
+}
+
+uint32_t compiled_dfa::encode(const interpretation& symbol) {
+  uint32_t result = 0;
+  for (size_t i = 0; i < symbol.size() && i < MAX_NB_VARIABLES; i++)
+    if (symbol[i])
+      result |= 1u << i;
+  return result;
+}
+
+uint32_t compiled_dfa::encode(const interpretation_set& symbol) {
+  uint32_t result = 0;
+  for (int variable : symbol)
+    if (variable < MAX_NB_VARIABLES)
+      result |= 1u << variable;
+  return result;
+}
+
+bool compiled_dfa::accepts(const trace& word) const {
+  int current_state = initial_state_;
+  for (const auto& symbol : word)
+    current_state = get_successor(current_state, encode(symbol) & mask_());
+  return is_final(current_state);
+}
+
+bool compiled_dfa::accepts(const std::vector<uint32_t>& word) const {
+  int current_state = initial_state_;
+  for (auto symbol : word)
+    current_state = get_successor(current_state, symbol);
+  return is_final(current_state);
+}
+
+static std::logic_error immutable_error() {
+  return std::logic_error("a compiled DFA cannot be modified");
+}
+
+int compiled_dfa::add_state() { throw immutable_error(); }
+void compiled_dfa::set_initial_state(int) { throw immutable_error(); }
+void compiled_dfa::set_final_state(int, bool) { throw immutable_error(); }
+void compiled_dfa::add_transition(int, const interpretation_map&, int) {
+  throw immutable_error();
+}
+void compiled_dfa::add_transition(int, const interpretation&, int, bool) {
+  throw immutable_error();
+}
+void compiled_dfa::add_transition(int, const interpretation_set&, int,
+                                  bool) {
+  throw immutable_error();
+}
+
+} // namespace whitemech::lydia
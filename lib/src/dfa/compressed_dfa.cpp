@@ -0,0 +1,213 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <climits>
+#include <lydia/dfa/compressed_dfa.hpp>
+#include <lydia/dfa/successor_bits.hpp>
+#include <map>
+#include <stdexcept>
+
+namespace whitemech::lydia {
+
+/*
+ * Build the classifier bottom-up. A leaf is identified by the successor
+ * of every state, so that the classes are the coarsest partition.
+ */
+class AlphabetClassifierBuilder {
+public:
+  AlphabetClassifier classifier;
+  // the successor of every state, for every class.
+  std::vector<std::vector<int>> successors;
+
+  explicit AlphabetClassifierBuilder(int nb_variables) {
+    classifier.nb_variables_ = nb_variables;
+  }
+
+  // path is an interpretation that leads to the leaf.
+  int make_leaf(const std::vector<int>& state_successors,
+                const interpretation& path) {
+    auto [it, inserted] =
+        class_ids_.emplace(state_successors, successors.size());
+    if (inserted) {
+      successors.push_back(state_successors);
+      classifier.representatives_.push_back(path);
+    }
+    return -it->second - 1;
+  }
+
+  int make_node(int variable, int low, int high) {
+    if (low == high)
+      return low;
+    classifier.nodes_.push_back({variable, low, high});
+    return classifier.nodes_.size() - 1;
+  }
+
+  void set_root(int root) { classifier.root_ = root; }
+
+private:
+  std::map<std::vector<int>, int> class_ids_;
+};
+
+int AlphabetClassifier::classify(const interpretation& symbol) const {
+  int current = root_;
+  while (current >= 0) {
+    const auto& node = nodes_[current];
+    current = symbol[node.variable] ? node.high : node.low;
+  }
+  return -current - 1;
+}
+
+/*
+ * Visit the BDDs of all the states at once. The next variable is the
+ * smallest one tested by the current nodes, and path is the
+ * interpretation of the path being visited.
+ */
+static int visit_mona(AlphabetClassifierBuilder& builder, const DFA* a,
+                      const std::vector<unsigned>& nodes,
+                      std::map<std::vector<unsigned>, int>& memo,
+                      interpretation& path) {
+  auto it = memo.find(nodes);
+  if (it != memo.end())
+    return it->second;
+
+  const bdd_record* node_table = a->bddm->node_table;
+  unsigned l, r, index;
+  unsigned variable = UINT_MAX;
+  for (auto node : nodes) {
+    LOAD_lri(&node_table[node], l, r, index);
+    if (index != BDD_LEAF_INDEX)
+      variable = std::min(variable, index);
+  }
+
+  int result;
+  if (variable == UINT_MAX) {
+    std::vector<int> state_successors;
+    state_successors.reserve(nodes.size());
+    for (auto node : nodes) {
+      LOAD_lri(&node_table[node], l, r, index);
+      state_successors.push_back(l);
+    }
+    result = builder.make_leaf(state_successors, path);
+  } else {
+    std::vector<unsigned> low(nodes), high(nodes);
+    for (size_t s = 0; s < nodes.size(); s++) {
+      LOAD_lri(&node_table[nodes[s]], l, r, index);
+      if (index == variable) {
+        low[s] = l;
+        high[s] = r;
+      }
+    }
+    path[variable] = 0;
+    int low_id = visit_mona(builder, a, low, memo, path);
+    path[variable] = 1;
+    int high_id = visit_mona(builder, a, high, memo, path);
+    path[variable] = 0;
+    result = builder.make_node(variable, low_id, high_id);
+  }
+  memo.emplace(nodes, result);
+  return result;
+}
+
+void compressed_dfa::init_(const abstract_dfa& automaton) {
+  nb_states_ = automaton.get_nb_states();
+  initial_state_ = automaton.get_initial_state();
+  finals_.resize(nb_states_);
+  for (int s = 0; s < nb_states_; s++)
+    finals_[s] = automaton.is_final(s);
+}
+
+static std::vector<uint32_t>
+make_table(const std::vector<std::vector<int>>& successors, int nb_states) {
+  const size_t nb_classes = successors.size();
+  std::vector<uint32_t> table(nb_states * nb_classes);
+  for (size_t c = 0; c < nb_classes; c++)
+    for (int s = 0; s < nb_states; s++)
+      table[s * nb_classes + c] = successors[c][s];
+  return table;
+}
+
+compressed_dfa::compressed_dfa(const mona_dfa& automaton) {
+  init_(automaton);
+  const DFA* a = automaton.dfa_;
+  AlphabetClassifierBuilder builder(automaton.get_nb_variables());
+  std::map<std::vector<unsigned>, int> memo;
+  auto path = interpretation(automaton.get_nb_variables(), 0);
+  auto roots = std::vector<unsigned>(a->q, a->q + a->ns);
+  builder.set_root(visit_mona(builder, a, roots, memo, path));
+  classifier_ = std::move(builder.classifier);
+  table_ = make_table(builder.successors, nb_states_);
+}
+
+compressed_dfa::compressed_dfa(const dfa& automaton) {
+  init_(automaton);
+  // the successor bits of all the states are visited at once.
+  vec_bdd bits;
+  bits.reserve(nb_states_ * automaton.nb_bits);
+  for (int s = 0; s < nb_states_; s++) {
+    auto successor_bits = automaton.get_successor_bits(s);
+    bits.insert(bits.end(), successor_bits.begin(), successor_bits.end());
+  }
+  AlphabetClassifierBuilder builder(automaton.get_nb_variables());
+  auto walker = SuccessorBitsWalker(
+      automaton,
+      [&](const std::vector<int>& state_successors,
+          const interpretation& path) {
+        return builder.make_leaf(state_successors, path);
+      },
+      [&](int position, int low_id, int high_id) {
+        return builder.make_node(position, low_id, high_id);
+      });
+  builder.set_root(walker.walk(bits));
+  classifier_ = std::move(builder.classifier);
+  table_ = make_table(builder.successors, nb_states_);
+}
+
+int compressed_dfa::get_successor(int state,
+                                  const interpretation_set& symbol) const {
+  interpretation vec_symbol(get_nb_variables(), 0);
+  for (int variable : symbol)
+    if (variable < get_nb_variables())
+      vec_symbol[variable] = 1;
+  return get_successor(state, vec_symbol);
+}
+
+bool compressed_dfa::accepts(const trace& word) const {
+  int current_state = initial_state_;
+  for (const auto& symbol : word)
+    current_state = get_successor(current_state, symbol);
+  return is_final(current_state);
+}
+
+static std::logic_error immutable_error() {
+  return std::logic_error("a compressed DFA cannot be modified");
+}
+
+int compressed_dfa::add_state() { throw immutable_error(); }
+void compressed_dfa::set_initial_state(int) { throw immutable_error(); }
+void compressed_dfa::set_final_state(int, bool) { throw immutable_error(); }
+void compressed_dfa::add_transition(int, const interpretation_map&, int) {
+  throw immutable_error();
+}
+void compressed_dfa::add_transition(int, const interpretation&, int, bool) {
+  throw immutable_error();
+}
+void compressed_dfa::add_transition(int, const interpretation_set&, int,
+                                    bool) {
+  throw immutable_error();
+}
+
+} // namespace whitemech::lydia
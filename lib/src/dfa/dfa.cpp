@@ -16,10 +16,14 @@
  */
 
 #include <cuddObj.hh>
+#include <functional>
 #include <lydia/dfa/dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <lydia/dfa/mona_file.hpp>
 #include <lydia/utils/misc.hpp>
 #include <lydia/utils/strings.hpp>
 #include <numeric>
+#include <unordered_map>
 
 namespace whitemech::lydia {
 
@@ -28,8 +32,10 @@ Logger dfa::logger = Logger("dfa");
 dfa::dfa(const CUDD::Cudd& mgr, int nb_bits, int nb_variables)
     : mgr{mgr}, nb_bits{nb_bits}, nb_states{1}, initial_state{0},
       nb_variables{nb_variables} {
+  if (nb_bits < 1)
+    throw std::invalid_argument("At least one bit is required.");
 
-  bddvars.reserve(nb_variables);
+  bddvars.reserve(nb_bits + nb_variables);
   root_bdds.reserve(nb_bits + nb_variables);
   variables.reserve(nb_variables);
 
@@ -72,9 +78,39 @@ CUDD::BDD dfa::prop2bddvar(int index, bool v) const {
 void dfa::construct_bdd_from_mona(
     const std::vector<std::vector<int>>& mona_bdd_nodes,
     const std::vector<int>& behaviour, const std::vector<int>& final_states) {
+  auto flat_nodes = std::vector<int>();
+  flat_nodes.reserve(3 * mona_bdd_nodes.size());
+  for (const auto& node : mona_bdd_nodes)
+    flat_nodes.insert(flat_nodes.end(), node.begin(), node.begin() + 3);
+  construct_bdd_from_mona(flat_nodes, behaviour, final_states);
+}
+
+void dfa::construct_bdd_from_mona(const std::vector<int>& mona_bdd_nodes,
+                                  const std::vector<int>& behaviour,
+                                  const std::vector<int>& final_states) {
+  check_mona_bdd(mona_bdd_nodes, nb_variables, nb_states, behaviour,
+                 final_states);
+  if (initial_state < 0 || initial_state >= nb_states)
+    throw std::runtime_error("Malformed MONA DFA: bad initial state");
+  auto tBDD = std::vector<vec_bdd>(mona_bdd_nodes.size() / 3);
+  create_variables();
+  // populate the tBDD mapping.
+  // Each item is associated to one MONA BDD node (both leaves and variables),
+  // and contains a vector of BDDs.
+  for (int i = 0; i < tBDD.size(); i++) {
+    if (tBDD[i].empty()) {
+      try_get(i, mona_bdd_nodes, tBDD);
+    }
+  }
+  auto successors = std::vector<vec_bdd>(nb_states);
+  for (int j = 0; j < nb_states; j++)
+    successors[j] = tBDD[behaviour[j]];
+  assign_successors(successors, final_states);
+}
+
+void dfa::create_variables() {
   // Create all the variables, the ones for the bits of the states and the ones
   // for the variables.
-  auto tBDD = std::vector<vec_bdd>(mona_bdd_nodes.size());
   for (int i = 0; i < nb_bits + nb_variables; i++) {
     CUDD::BDD b = mgr.bddVar();
     bddvars.push_back(b);
@@ -85,45 +121,40 @@ void dfa::construct_bdd_from_mona(
     CUDD::BDD d = mgr.bddZero();
     root_bdds.push_back(d);
   }
-  // populate the tBDD mapping.
-  // Each item is associated to one MONA BDD node (both leaves and variables),
-  // and contains a vector of BDDs.
-  for (int i = 0; i < tBDD.size(); i++) {
-    if (tBDD[i].empty()) {
-      vec_bdd b = try_get(i, mona_bdd_nodes, tBDD);
-    }
-  }
-  // Assign each state to the next BDD node.
-  // Basically, this for loop processes the content of the MONA DFA 'behaviour'
-  // vector.
-  for (int i = 0; i < nb_bits; i++) {
-    for (int j = 0; j < nb_states; j++) {
-      // Build the BDD representation of a state.
-      // we set the temporary variable to 1 because
-      // we are going to put it in 'AND' later.
-      CUDD::BDD tmp = mgr.bddOne();
-      // the first for-loop handles the most significant bits
-      // that are not covered by the binary representation.
-      // the second for-loop handles all the other bits.
-      std::string bins = state2bin(j, nb_bits, true);
-      for (int m = 0; m < nb_bits; m++) {
-        bool bit_mth = int(bins[m]) - '0';
-        tmp = tmp * var2bddvar(m, bit_mth);
-      }
-      // Now, put in 'AND' with the correct BDD node
-      // (either terminal/leaf or variable) at the bit i_th.
-      tmp = tmp * tBDD[behaviour[j]][i];
-      // Put each root bdd in OR with the current temporary BDD.
-      root_bdds[i] = root_bdds[i] + tmp;
-    }
-  }
+}
 
-  // Create the BDD for recognizing the accepting states.
-  finalstatesBDD = mgr.bddZero();
-  for (int finalstate : final_states) {
-    CUDD::BDD ac = state2bdd(finalstate);
-    finalstatesBDD += ac;
+void dfa::assign_successors(const std::vector<vec_bdd>& successors,
+                            const std::vector<int>& final_states) {
+  // the leaves of the multiplexer: the bits of the successor,
+  // followed by the finality of the state.
+  auto leaves = std::vector<vec_bdd>(nb_states);
+  for (int j = 0; j < nb_states; j++) {
+    leaves[j] = successors[j];
+    leaves[j].push_back(mgr.bddZero());
   }
+  for (int finalstate : final_states)
+    leaves[finalstate][nb_bits] = mgr.bddOne();
+
+  auto result = multiplex(leaves, nb_bits - 1, 0);
+  finalstatesBDD = result.back();
+  result.pop_back();
+  root_bdds = std::move(result);
+}
+
+vec_bdd dfa::multiplex(const std::vector<vec_bdd>& leaves, int bit,
+                       int offset) const {
+  const size_t width = nb_bits + 1;
+  // encodings not associated to any state are mapped to zero.
+  if (offset >= nb_states)
+    return vec_bdd(width, mgr.bddZero());
+  if (bit < 0)
+    return leaves[offset];
+  vec_bdd low = multiplex(leaves, bit - 1, offset);
+  vec_bdd high = multiplex(leaves, bit - 1, offset + (1 << bit));
+  const CUDD::BDD& b = bddvars[bit];
+  for (size_t k = 0; k < width; k++)
+    low[k] = b.Ite(high[k], low[k]);
+  return low;
 }
 
 CUDD::BDD dfa::state2bdd(int s) {
@@ -136,42 +167,41 @@ CUDD::BDD dfa::state2bdd(int s) {
   return b;
 }
 
-vec_bdd dfa::try_get(int index,
-                     const std::vector<std::vector<int>>& mona_bdd_nodes,
-                     std::vector<vec_bdd>& tBDD) {
+vec_bdd dfa::get_successor_bits(int state) const {
+  std::string bin = state2bin(state, nb_bits, true);
+  CUDD::BDD cube = mgr.bddOne();
+  for (int j = 0; j < nb_bits; j++)
+    cube *= var2bddvar(j, bin[j] == '1');
+  vec_bdd result;
+  result.reserve(nb_bits);
+  for (const auto& root : root_bdds)
+    result.push_back(root.Cofactor(cube));
+  return result;
+}
+
+const vec_bdd& dfa::try_get(int index, const std::vector<int>& mona_bdd_nodes,
+                            std::vector<vec_bdd>& tBDD) {
   if (!tBDD[index].empty())
     return tBDD[index];
   vec_bdd b;
   b.reserve(nb_bits);
-  if (mona_bdd_nodes[index][0] == -1) {
+  const int* node = mona_bdd_nodes.data() + 3 * index;
+  if (node[0] == -1) {
     // case when BDD node is a leaf
     // the format is: "-1 val 0"
-    int value = mona_bdd_nodes[index][1];
-    // get the binary representation of the state
-    std::string bins = state2bin(value, nb_bits, true);
-    for (char bin : bins) {
-      if (bin == '0') {
-        CUDD::BDD temp_bdd = mgr.bddZero();
-        b.push_back(temp_bdd);
-      } else if (bin == '1') {
-        CUDD::BDD temp_bdd = mgr.bddOne();
-        b.push_back(temp_bdd);
-      } else {
-        logger.error("error binary state");
-        assert(false);
-      }
-    }
-    tBDD[index] = b;
-    return b;
+    int value = node[1];
+    // the bits of the state, least significant first.
+    for (int i = 0; i < nb_bits; i++)
+      b.push_back(((value >> i) & 1) ? mgr.bddOne() : mgr.bddZero());
   } else {
     // case when BDD node is an intermediate node
     // root index != -1
-    int rootindex = mona_bdd_nodes[index][0];
-    int leftindex = mona_bdd_nodes[index][1];
-    int rightindex = mona_bdd_nodes[index][2];
+    int rootindex = node[0];
+    int leftindex = node[1];
+    int rightindex = node[2];
     CUDD::BDD root = bddvars[nb_bits + rootindex];
-    vec_bdd low = try_get(leftindex, mona_bdd_nodes, tBDD);
-    vec_bdd high = try_get(rightindex, mona_bdd_nodes, tBDD);
+    const vec_bdd& low = try_get(leftindex, mona_bdd_nodes, tBDD);
+    const vec_bdd& high = try_get(rightindex, mona_bdd_nodes, tBDD);
     assert(low.size() == high.size());
     assert(low.size() == nb_bits);
     for (int i = 0; i < low.size(); i++) {
@@ -179,102 +209,27 @@ vec_bdd dfa::try_get(int index,
       CUDD::BDD tmp = root.Ite(high[i], low[i]);
       b.push_back(tmp);
     }
-    tBDD[index] = b;
-    return b;
   }
+  tBDD[index] = std::move(b);
+  return tBDD[index];
 }
 
 dfa dfa::read_from_file(const std::string& filename, const CUDD::Cudd& mgr) {
-  int nb_variables = -1;
-  std::vector<std::string> variables;
-  int nb_states = -1;
-  int initial_state = -1;
-  int nb_nodes = -1;
-  std::vector<item> mona_bdd_nodes;
-  std::vector<int> final_states;
-  std::vector<int> behaviour;
-
-  std::ifstream f(filename.c_str());
-  if (f.is_open()) {
-    bool flag = 0;
-    std::string line;
-    item tmp;                        // item: vector<int>
-    std::vector<std::string> fields; // temporary varibale
-
-    while (getline(f, line)) {
-      if (flag == 0) {
-        if (strfind(line, "number of variables")) {
-          fields = split(line, " +");
-          nb_variables = stoi(fields[3]);
-          whitemech::lydia::dfa::logger.debug("number of variables: {}",
-                                              nb_variables);
-        }
-        if (strfind(line, "variables") && !strfind(line, "number")) {
-          variables = split(line, " +");
-          variables.erase(variables.begin());
-          whitemech::lydia::dfa::logger.debug("variables: {}", join(variables));
-        } else if (strfind(line, "states")) {
-          fields = split(line, " +");
-          nb_states = stoi(fields[1]);
-          whitemech::lydia::dfa::logger.debug("number of states: {}",
-                                              nb_states);
-        } else if (strfind(line, "initial")) {
-          fields = split(line, " +");
-          initial_state = stoi(fields[1]);
-          whitemech::lydia::dfa::logger.debug("initial state: {}",
-                                              initial_state);
-        } else if (strfind(line, "bdd nodes")) {
-          fields = split(line, " ");
-          nb_nodes = stoi(fields[2]);
-          whitemech::lydia::dfa::logger.debug("nb nodes: {}", nb_nodes);
-        } else if (strfind(line, "final")) {
-          fields = split(line, " +");
-          int i = 1; // start at 1 to ignore "final" token
-          while (i < fields.size()) {
-            if (fields[i] == "1")
-              final_states.push_back(i - 1);
-            i = i + 1;
-          }
-          whitemech::lydia::dfa::logger.debug("final states: {}",
-                                              print_vect_int(final_states));
-        } else if (strfind(line, "behaviour")) {
-          fields = split(line, " +");
-          int i = 1;
-          while (i < fields.size()) {
-            behaviour.push_back(stoi(fields[i]));
-            i = i + 1;
-          }
-          whitemech::lydia::dfa::logger.debug("behaviour: {}",
-                                              print_vect_int(behaviour));
-        } else if (strfind(line, "bdd:"))
-          flag = 1;
-        else
-          continue;
-      } else {
-        if (strfind(line, "end"))
-          break;
-        fields = split(line, " +");
-        for (int i = 1; i < fields.size(); i++)
-          tmp.push_back(stoi(fields[i]));
-        mona_bdd_nodes.push_back(tmp);
-        tmp.clear();
-      }
-    }
-  } else {
-    throw std::runtime_error("No such file or directory: " + filename);
-  }
-  f.close();
-
-  // consistency checks
-  assert(nb_variables > 0);
-  assert(nb_states > 0);
-  assert(initial_state >= 0 && initial_state < nb_states);
-  for (auto final_state : final_states)
-    assert(final_state >= 0 && final_state < nb_states);
-  assert(mona_bdd_nodes.size() == nb_nodes);
+  auto file = parse_mona_dfa_file(filename);
+  whitemech::lydia::dfa::logger.debug("number of variables: {}",
+                                      file.variables.size());
+  whitemech::lydia::dfa::logger.debug("number of states: {}", file.nb_states);
+  whitemech::lydia::dfa::logger.debug("nb nodes: {}", file.get_nb_nodes());
+  return dfa(mgr, file);
+}
 
-  return dfa(mgr, variables, nb_states, initial_state, final_states, behaviour,
-             mona_bdd_nodes);
+dfa::dfa(const CUDD::Cudd& mgr, const MonaDFAFile& file) : mgr{mgr} {
+  this->nb_variables = file.variables.size();
+  this->nb_states = file.nb_states;
+  this->nb_bits = state2bin(nb_states - 1).length();
+  this->initial_state = file.initial_state;
+  this->variables = file.variables;
+  construct_bdd_from_mona(file.bdd_nodes, file.behaviour, file.final_states);
 }
 
 dfa::dfa(const CUDD::Cudd& mgr, const std::vector<std::string>& variables,
@@ -289,9 +244,68 @@ dfa::dfa(const CUDD::Cudd& mgr, const std::vector<std::string>& variables,
   construct_bdd_from_mona(mona_bdd_nodes, behaviour, final_states);
 }
 
+dfa::dfa(const CUDD::Cudd& mgr, const mona_dfa& automaton) : mgr{mgr} {
+  const DFA* a = automaton.dfa_;
+  bdd_manager* bddm = a->bddm;
+  this->nb_variables = automaton.get_nb_variables();
+  this->nb_states = a->ns;
+  this->nb_bits = state2bin(nb_states - 1).length();
+  this->initial_state = a->s;
+  this->variables = automaton.names;
+  create_variables();
+  std::unordered_map<unsigned, int> index2position;
+  for (int i = 0; i < nb_variables; i++)
+    index2position[automaton.indices[i]] = i;
+
+  // translate the MONA nodes reachable from the states, bottom-up.
+  std::unordered_map<bdd_ptr, vec_bdd> node2bdds;
+  std::function<const vec_bdd&(bdd_ptr)> translate =
+      [&](bdd_ptr p) -> const vec_bdd& {
+    auto it = node2bdds.find(p);
+    if (it != node2bdds.end())
+      return it->second;
+    unsigned l, r, index;
+    LOAD_lri(&bddm->node_table[p], l, r, index);
+    vec_bdd b;
+    b.reserve(nb_bits);
+    if (index == BDD_LEAF_INDEX) {
+      // the value of a leaf is the successor state.
+      std::string bins = state2bin(l, nb_bits, true);
+      for (char bin : bins)
+        b.push_back(bin == '1' ? mgr.bddOne() : mgr.bddZero());
+    } else {
+      CUDD::BDD root = bddvars[nb_bits + index2position.at(index)];
+      // references to the elements of an unordered_map survive rehashing.
+      const vec_bdd& low = translate(l);
+      const vec_bdd& high = translate(r);
+      for (int i = 0; i < nb_bits; i++)
+        b.push_back(root.Ite(high[i], low[i]));
+    }
+    return node2bdds.emplace(p, std::move(b)).first->second;
+  };
+
+  auto successors = std::vector<vec_bdd>(nb_states);
+  std::vector<int> final_states;
+  for (int j = 0; j < nb_states; j++) {
+    successors[j] = translate(a->q[j]);
+    if (a->f[j] == 1)
+      final_states.push_back(j);
+  }
+  assign_successors(successors, final_states);
+}
+
+std::vector<int> dfa::make_eval_buffer() const {
+  return std::vector<int>(mgr.ReadSize(), 0);
+}
+
+void dfa::set_value(std::vector<int>& buffer, int position,
+                     int value) const {
+  buffer[bddvars[position].NodeReadIndex()] = value;
+}
+
 bool dfa::accepts(const trace& word) const {
   //  we preallocate the vector for performance purposes
-  std::vector<int> extended_symbol = std::vector<int>(nb_bits + nb_variables);
+  std::vector<int> extended_symbol = make_eval_buffer();
   std::vector<int> next_state = std::vector<int>(nb_bits);
   std::vector<int> current_state = std::vector<int>(nb_bits);
 
@@ -305,28 +319,35 @@ bool dfa::accepts(const trace& word) const {
     current_state = next_state;
     get_successor(current_state, symbol, next_state, extended_symbol);
   }
-  return finalstatesBDD.Eval(next_state.data()).IsOne();
+  for (int i = 0; i < nb_bits; i++)
+    set_value(extended_symbol, i, next_state[i]);
+  return finalstatesBDD.Eval(extended_symbol.data()).IsOne();
 }
 
 int dfa::add_state() {
   int new_state = nb_states;
   auto new_nb_bits = bit_length(new_state);
   if (nb_bits < new_nb_bits) {
-    /* TODO discuss: that requires a variable number of bits!
-     *      How to deal with final_states_BDD?
-     *
-     *    // add new state variable
-     *    CUDD::BDD b = mgr.bddVar();
-     *    bddvars.insert(bddvars.begin() + nb_bits, b);
-     *    ++nb_bits;
-     */
-    throw std::invalid_argument(
-        "Maximum number of states reached: Cannot instantiate a new bit.");
+    add_bit();
   }
   ++nb_states;
   return new_state;
 }
 
+void dfa::add_bit() {
+  CUDD::BDD b = mgr.bddVar();
+  // all the states added so far have the new (most significant) bit set to 0.
+  CUDD::BDD not_b = !b;
+  for (auto& root_bdd : root_bdds) {
+    root_bdd *= not_b;
+  }
+  finalstatesBDD *= not_b;
+  root_bdds.push_back(mgr.bddZero());
+  bddvars.insert(bddvars.begin() + nb_bits, b);
+  ++nb_bits;
+  logger.debug("added bit {}", nb_bits - 1);
+}
+
 void dfa::set_initial_state(int state) {
   if (state >= nb_states) {
     throw std::invalid_argument("The state is not in the set of states.");
@@ -388,10 +409,24 @@ void dfa::add_transition(int from, const interpretation_set& symbol, int to,
   add_transition(from, new_symbol, to);
 }
 
+void dfa::add_transition(int from, const CUDD::BDD& guard, int to) {
+  if (from >= nb_states)
+    throw std::invalid_argument("'from' state is not in the set of states.");
+  if (to >= nb_states)
+    throw std::invalid_argument("'to' state is not in the set of states.");
+
+  std::string to_binary = state2bin(to, nb_bits, true);
+  CUDD::BDD tmp = state2bdd(from) * guard;
+  for (int i = 0; i < nb_bits; i++) {
+    if (to_binary[i] == '1')
+      root_bdds[i] += tmp;
+  }
+}
+
 int dfa::get_successor(int state, const interpretation& symbol) const {
   std::vector<int> current_state = std::vector<int>(nb_bits);
   std::vector<int> next_state(nb_bits);
-  std::vector<int> extended_symbol(nb_bits + nb_variables);
+  std::vector<int> extended_symbol = make_eval_buffer();
 
   auto initial_state_bits = state2bin(state, nb_bits, true);
   for (int i = 0; i < nb_bits; i++)
@@ -410,10 +445,10 @@ void dfa::get_successor(const std::vector<int>& state,
   auto offset = nb_bits;
   // set state bits part
   for (int i = 0; i < nb_bits; i++)
-    extended_symbol[i] = state[i];
+    set_value(extended_symbol, i, state[i]);
   // set symbol part
   for (int i = 0; i < nb_variables; i++)
-    extended_symbol[offset + i] = symbol[i];
+    set_value(extended_symbol, offset + i, symbol[i]);
 
   // compute next state
   int* extended_symbol_data = extended_symbol.data();
@@ -430,9 +465,34 @@ int dfa::get_successor(int state, const interpretation_set& symbol) const {
   return get_successor(state, vec_symbol);
 }
 
+int dfa::get_successor(int state, const interpretation_bits& symbol) const {
+  // the buffer is reused across the calls of the same thread.
+  thread_local std::vector<int> extended_symbol;
+  extended_symbol.assign(mgr.ReadSize(), 0);
+  for (int i = 0; i < nb_bits; i++)
+    set_value(extended_symbol, i, (state >> i) & 1);
+  for (int i = 0; i < nb_variables; i++)
+    set_value(extended_symbol, nb_bits + i, symbol.test(i));
+
+  // evaluate the raw nodes, so that no reference count is updated.
+  DdManager* manager = mgr.getManager();
+  DdNode* one = Cudd_ReadOne(manager);
+  int result = 0;
+  for (int i = 0; i < nb_bits; i++) {
+    DdNode* value =
+        Cudd_Eval(manager, root_bdds[i].getNode(), extended_symbol.data());
+    if (value == one)
+      result |= 1 << i;
+  }
+  return result;
+}
+
 bool dfa::is_final(int state) const {
   std::vector<int> state_as_binary_vect = state2binvec(state, nb_bits);
-  return finalstatesBDD.Eval(state_as_binary_vect.data()).IsOne();
+  std::vector<int> buffer = make_eval_buffer();
+  for (int i = 0; i < nb_bits; i++)
+    set_value(buffer, i, state_as_binary_vect[i]);
+  return finalstatesBDD.Eval(buffer.data()).IsOne();
 }
 
 CUDD::BDD dfa::get_symbol(const interpretation_map& i) const {
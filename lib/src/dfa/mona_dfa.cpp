@@ -16,6 +16,7 @@
  */
 
 #include <lydia/dfa/mona_dfa.hpp>
+#include <stdexcept>
 
 namespace whitemech::lydia {
 
@@ -41,6 +42,49 @@ int mona_dfa::get_successor(int state, const interpretation& symbol) const {
   return l;
 }
 
+int mona_dfa::get_successor(int state,
+                            const interpretation_set& symbol) const {
+  bdd_manager* mgr = this->dfa_->bddm;
+  unsigned l, r, index;
+  unsigned current_node = dfa_->q[state];
+  LOAD_lri(&mgr->node_table[current_node], l, r, index);
+  while (index != BDD_LEAF_INDEX) {
+    current_node = symbol.find(index) != symbol.end() ? r : l;
+    LOAD_lri(&mgr->node_table[current_node], l, r, index);
+  }
+  return l;
+}
+
+int mona_dfa::get_successor(int state,
+                            const interpretation_bits& symbol) const {
+  bdd_manager* mgr = this->dfa_->bddm;
+  unsigned l, r, index;
+  unsigned current_node = dfa_->q[state];
+  LOAD_lri(&mgr->node_table[current_node], l, r, index);
+  while (index != BDD_LEAF_INDEX) {
+    current_node = symbol.test(index) ? r : l;
+    LOAD_lri(&mgr->node_table[current_node], l, r, index);
+  }
+  return l;
+}
+
+static std::logic_error immutable_error() {
+  return std::logic_error("a MONA DFA cannot be modified");
+}
+
+int mona_dfa::add_state() { throw immutable_error(); }
+void mona_dfa::set_initial_state(int) { throw immutable_error(); }
+void mona_dfa::set_final_state(int, bool) { throw immutable_error(); }
+void mona_dfa::add_transition(int, const interpretation_map&, int) {
+  throw immutable_error();
+}
+void mona_dfa::add_transition(int, const interpretation&, int, bool) {
+  throw immutable_error();
+}
+void mona_dfa::add_transition(int, const interpretation_set&, int, bool) {
+  throw immutable_error();
+}
+
 void mona_dfa::export_dfa(const std::string& filename) const {
   std::vector<char> filename_cstr(filename.c_str(),
                                   filename.c_str() + filename.size() + 1);
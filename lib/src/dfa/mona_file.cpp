@@ -0,0 +1,202 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <climits>
+#include <cstring>
+#include <lydia/dfa/mona_file.hpp>
+#include <lydia/utils/mapped_file.hpp>
+#include <stdexcept>
+#include <utility>
+
+namespace whitemech::lydia {
+
+/*
+ * A cursor over the buffer. Tokens are separated by whitespace.
+ */
+class MonaTokenizer {
+private:
+  const char* current_;
+  const char* const end_;
+
+  static bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+  }
+
+  [[noreturn]] static void fail(const std::string& message) {
+    throw std::runtime_error("Malformed MONA DFA file: " + message);
+  }
+
+public:
+  MonaTokenizer(const char* begin, const char* end)
+      : current_{begin}, end_{end} {}
+
+  void skip_spaces() {
+    while (current_ != end_ && is_space(*current_))
+      ++current_;
+  }
+
+  void expect(const char* keyword) {
+    skip_spaces();
+    size_t length = std::strlen(keyword);
+    if ((size_t)(end_ - current_) < length ||
+        std::memcmp(current_, keyword, length) != 0)
+      fail(std::string("expected '") + keyword + "'");
+    current_ += length;
+  }
+
+  int next_int() {
+    skip_spaces();
+    bool negative = false;
+    if (current_ != end_ && *current_ == '-') {
+      negative = true;
+      ++current_;
+    }
+    if (current_ == end_ || *current_ < '0' || *current_ > '9')
+      fail("expected an integer");
+    long long value = 0;
+    while (current_ != end_ && *current_ >= '0' && *current_ <= '9') {
+      value = value * 10 + (*current_ - '0');
+      if (value > INT_MAX)
+        fail("integer out of range");
+      ++current_;
+    }
+    return (int)(negative ? -value : value);
+  }
+
+  std::string next_word() {
+    skip_spaces();
+    const char* begin = current_;
+    while (current_ != end_ && !is_space(*current_))
+      ++current_;
+    if (begin == current_)
+      fail("expected a word");
+    return std::string(begin, current_);
+  }
+};
+
+void check_mona_bdd(const std::vector<int>& bdd_nodes, int nb_variables,
+                    int nb_states, const std::vector<int>& behaviour,
+                    const std::vector<int>& final_states) {
+  auto fail = [](const std::string& message) {
+    throw std::runtime_error("Malformed MONA DFA: " + message);
+  };
+  const int nb_nodes = bdd_nodes.size() / 3;
+  for (int id = 0; id < nb_nodes; id++) {
+    const int* node = bdd_nodes.data() + 3 * id;
+    if (node[0] < -1 || node[0] >= nb_variables)
+      fail("bad variable index");
+    if (node[0] == -1 && (node[1] < 0 || node[1] >= nb_states))
+      fail("bad successor state");
+    if (node[0] != -1 &&
+        (node[1] < 0 || node[1] >= nb_nodes || node[2] < 0 ||
+         node[2] >= nb_nodes))
+      fail("bad node reference");
+  }
+  if ((int)behaviour.size() != nb_states)
+    fail("bad number of behaviours");
+  for (int root : behaviour)
+    if (root < 0 || root >= nb_nodes)
+      fail("bad state root");
+  for (int state : final_states)
+    if (state < 0 || state >= nb_states)
+      fail("bad final state");
+
+  // the nodes may be in any order: look for a cycle with a depth-first
+  // visit, where the nodes on the stack are "open".
+  enum : char { NEW, OPEN, DONE };
+  auto status = std::vector<char>(nb_nodes, NEW);
+  auto stack = std::vector<std::pair<int, int>>();
+  for (int start = 0; start < nb_nodes; start++) {
+    if (status[start] != NEW)
+      continue;
+    status[start] = OPEN;
+    stack.emplace_back(start, 0);
+    while (!stack.empty()) {
+      auto& [id, next_child] = stack.back();
+      const int* node = bdd_nodes.data() + 3 * id;
+      if (node[0] == -1 || next_child == 2) {
+        status[id] = DONE;
+        stack.pop_back();
+        continue;
+      }
+      int child = node[1 + next_child++];
+      if (status[child] == OPEN)
+        fail("cyclic node reference");
+      if (status[child] == NEW) {
+        status[child] = OPEN;
+        stack.emplace_back(child, 0);
+      }
+    }
+  }
+}
+
+MonaDFAFile parse_mona_dfa(const char* begin, const char* end) {
+  MonaDFAFile result;
+  auto tokenizer = MonaTokenizer(begin, end);
+  tokenizer.expect("MONA DFA");
+
+  tokenizer.expect("number of variables:");
+  int nb_variables = tokenizer.next_int();
+  if (nb_variables < 0)
+    throw std::runtime_error("Malformed MONA DFA file: negative variables");
+  tokenizer.expect("variables:");
+  result.variables.reserve(nb_variables);
+  for (int i = 0; i < nb_variables; i++)
+    result.variables.push_back(tokenizer.next_word());
+  tokenizer.expect("orders:");
+  for (int i = 0; i < nb_variables; i++)
+    tokenizer.next_int();
+
+  tokenizer.expect("states:");
+  result.nb_states = tokenizer.next_int();
+  tokenizer.expect("initial:");
+  result.initial_state = tokenizer.next_int();
+  tokenizer.expect("bdd nodes:");
+  int nb_nodes = tokenizer.next_int();
+  if (result.nb_states <= 0 || nb_nodes < 0)
+    throw std::runtime_error("Malformed MONA DFA file: negative size");
+  if (result.initial_state < 0 || result.initial_state >= result.nb_states)
+    throw std::runtime_error("Malformed MONA DFA file: bad initial state");
+
+  tokenizer.expect("final:");
+  for (int i = 0; i < result.nb_states; i++) {
+    int status = tokenizer.next_int();
+    if (status < -1 || status > 1)
+      throw std::runtime_error("Malformed MONA DFA file: bad final status");
+    if (status == 1)
+      result.final_states.push_back(i);
+  }
+  tokenizer.expect("behaviour:");
+  result.behaviour.resize(result.nb_states);
+  for (int i = 0; i < result.nb_states; i++)
+    result.behaviour[i] = tokenizer.next_int();
+
+  tokenizer.expect("bdd:");
+  result.bdd_nodes.resize(3 * (size_t)nb_nodes);
+  for (size_t i = 0; i < result.bdd_nodes.size(); i++)
+    result.bdd_nodes[i] = tokenizer.next_int();
+  tokenizer.expect("end");
+  check_mona_bdd(result.bdd_nodes, nb_variables, result.nb_states,
+                 result.behaviour, result.final_states);
+  return result;
+}
+
+MonaDFAFile parse_mona_dfa_file(const std::string& filename) {
+  MappedFile file(filename);
+  return parse_mona_dfa(file.begin(), file.end());
+}
+
+} // namespace whitemech::lydia
@@ -0,0 +1,80 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <lydia/dfa/successor_bits.hpp>
+
+namespace whitemech::lydia {
+
+SuccessorBitsWalker::SuccessorBitsWalker(const dfa& automaton,
+                                         leaf_function make_leaf,
+                                         node_function make_node)
+    : automaton_{automaton}, make_leaf_{std::move(make_leaf)},
+      make_node_{std::move(make_node)},
+      path_(automaton.get_nb_variables(), 0) {}
+
+int SuccessorBitsWalker::walk_(const vec_bdd& bits, int position) {
+  std::vector<DdNode*> key;
+  key.reserve(bits.size());
+  for (const auto& bit : bits)
+    key.push_back(bit.getNode());
+  auto it = memo_.find(key);
+  if (it != memo_.end())
+    return it->second;
+
+  const int nb_bits = automaton_.nb_bits;
+  const int nb_variables = automaton_.get_nb_variables();
+  int result;
+  bool is_leaf = std::all_of(bits.begin(), bits.end(), [](const auto& bit) {
+    return bit.IsOne() || bit.IsZero();
+  });
+  if (is_leaf) {
+    std::vector<int> successors(bits.size() / nb_bits, 0);
+    for (size_t s = 0; s < successors.size(); s++)
+      for (int i = 0; i < nb_bits; i++)
+        if (bits[s * nb_bits + i].IsOne())
+          successors[s] |= 1 << i;
+    result = make_leaf_(successors, path_);
+  } else {
+    // skip the variables the bits do not depend on.
+    vec_bdd low, high;
+    for (; position < nb_variables; position++) {
+      const auto& var = automaton_.bddvars[nb_bits + position];
+      low.clear();
+      high.clear();
+      for (const auto& bit : bits) {
+        low.push_back(bit.Cofactor(!var));
+        high.push_back(bit.Cofactor(var));
+      }
+      if (low != high)
+        break;
+    }
+    assert(position < nb_variables);
+    path_[position] = 0;
+    int low_id = walk_(low, position + 1);
+    path_[position] = 1;
+    int high_id = walk_(high, position + 1);
+    path_[position] = 0;
+    result = make_node_(position, low_id, high_id);
+  }
+  alive_.push_back(bits);
+  memo_.emplace(std::move(key), result);
+  return result;
+}
+
+} // namespace whitemech::lydia
@@ -0,0 +1,221 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <lydia/logic/atom_ordering.hpp>
+#include <lydia/logic/atom_visitor.hpp>
+#include <map>
+#include <numeric>
+
+namespace whitemech::lydia {
+
+class AtomHyperedgesVisitor : public Visitor {
+public:
+  std::vector<set_atoms_ptr> hyperedges;
+
+  void visit(const LDLfAnd& x) override {
+    for (const auto& a : x.get_container())
+      a->accept(*this);
+  }
+  void visit(const LDLfOr& x) override {
+    for (const auto& a : x.get_container())
+      a->accept(*this);
+  }
+  void visit(const LDLfNot& x) override { x.get_arg()->accept(*this); }
+  void visit(const LDLfDiamond& x) override {
+    x.get_regex()->accept(*this);
+    x.get_formula()->accept(*this);
+  }
+  void visit(const LDLfBox& x) override {
+    x.get_regex()->accept(*this);
+    x.get_formula()->accept(*this);
+  }
+
+  void visit(const PropositionalRegExp& r) override {
+    add_(find_atoms(*r.get_arg()));
+  }
+  void visit(const TestRegExp& r) override { r.get_arg()->accept(*this); }
+  void visit(const UnionRegExp& r) override {
+    for (const auto& a : r.get_container())
+      a->accept(*this);
+  }
+  void visit(const SequenceRegExp& r) override {
+    const auto& container = r.get_container();
+    set_atoms_ptr previous;
+    for (const auto& a : container) {
+      a->accept(*this);
+      // consecutive elements of a sequence are combined in a product.
+      auto current = AtomsVisitor().apply(*a);
+      auto edge = previous;
+      edge.insert(current.begin(), current.end());
+      add_(edge);
+      previous = std::move(current);
+    }
+  }
+  void visit(const StarRegExp& r) override { r.get_arg()->accept(*this); }
+
+private:
+  void add_(const set_atoms_ptr& edge) {
+    if (edge.size() >= 2)
+      hyperedges.push_back(edge);
+  }
+};
+
+std::vector<set_atoms_ptr> atom_hyperedges(const LDLfFormula& formula) {
+  AtomHyperedgesVisitor visitor;
+  formula.accept(visitor);
+  return visitor.hyperedges;
+}
+
+size_t total_span(const std::vector<atom_ptr>& order,
+                  const std::vector<set_atoms_ptr>& hyperedges) {
+  std::map<atom_ptr, size_t, SharedComparator> position;
+  for (size_t i = 0; i < order.size(); i++)
+    position[order[i]] = i;
+  size_t span = 0;
+  for (const auto& edge : hyperedges) {
+    size_t min = order.size();
+    size_t max = 0;
+    for (const auto& atom : edge) {
+      min = std::min(min, position[atom]);
+      max = std::max(max, position[atom]);
+    }
+    span += max - min;
+  }
+  return span;
+}
+
+std::vector<atom_ptr>
+LexicographicOrdering::order(const LDLfFormula&,
+                             const set_atoms_ptr& atoms) const {
+  return std::vector<atom_ptr>(atoms.begin(), atoms.end());
+}
+
+std::vector<atom_ptr> ForceOrdering::order(const LDLfFormula& formula,
+                                           const set_atoms_ptr& atoms) const {
+  auto current = std::vector<atom_ptr>(atoms.begin(), atoms.end());
+  const size_t n = current.size();
+  std::map<atom_ptr, size_t, SharedComparator> atom2index;
+  for (size_t i = 0; i < n; i++)
+    atom2index[current[i]] = i;
+  // hyperedges as lists of (initial) atom indices.
+  std::vector<std::vector<size_t>> edges;
+  for (const auto& edge : atom_hyperedges(formula)) {
+    std::vector<size_t> indices;
+    for (const auto& atom : edge)
+      indices.push_back(atom2index.at(atom));
+    edges.push_back(std::move(indices));
+  }
+
+  auto position = std::vector<double>(n);
+  std::iota(position.begin(), position.end(), 0.0);
+  auto span = [&](const std::vector<double>& pos) {
+    double result = 0;
+    for (const auto& edge : edges) {
+      double min = n, max = 0;
+      for (auto i : edge) {
+        min = std::min(min, pos[i]);
+        max = std::max(max, pos[i]);
+      }
+      result += max - min;
+    }
+    return result;
+  };
+
+  auto best_position = position;
+  double best_span = span(position);
+  auto sum = std::vector<double>(n);
+  auto degree = std::vector<size_t>(n);
+  auto permutation = std::vector<size_t>(n);
+  for (size_t iteration = 0; iteration < max_iterations; iteration++) {
+    std::fill(sum.begin(), sum.end(), 0.0);
+    std::fill(degree.begin(), degree.end(), 0);
+    for (const auto& edge : edges) {
+      double center_of_gravity = 0;
+      for (auto i : edge)
+        center_of_gravity += position[i];
+      center_of_gravity /= edge.size();
+      for (auto i : edge) {
+        sum[i] += center_of_gravity;
+        ++degree[i];
+      }
+    }
+    auto tentative = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++)
+      tentative[i] = degree[i] == 0 ? position[i] : sum[i] / degree[i];
+    // ties are broken by the current position.
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::stable_sort(permutation.begin(), permutation.end(),
+                     [&](size_t i, size_t j) {
+                       if (tentative[i] != tentative[j])
+                         return tentative[i] < tentative[j];
+                       return position[i] < position[j];
+                     });
+    for (size_t k = 0; k < n; k++)
+      position[permutation[k]] = k;
+    double current_span = span(position);
+    if (current_span >= best_span)
+      break;
+    best_span = current_span;
+    best_position = position;
+  }
+
+  auto result = std::vector<atom_ptr>(n);
+  for (size_t i = 0; i < n; i++)
+    result[(size_t)best_position[i]] = current[i];
+  return result;
+}
+
+std::vector<atom_ptr>
+InterleavedOrdering::order(const LDLfFormula& formula,
+                           const set_atoms_ptr& atoms) const {
+  std::map<std::string, atom_ptr> name2atom;
+  for (const auto& atom : atoms)
+    name2atom[atom->str()] = atom;
+
+  auto result = std::vector<atom_ptr>();
+  set_atoms_ptr added;
+  size_t max_group_size = 0;
+  for (const auto& group : groups)
+    max_group_size = std::max(max_group_size, group.size());
+  for (size_t k = 0; k < max_group_size; k++) {
+    for (const auto& group : groups) {
+      if (k >= group.size())
+        continue;
+      auto it = name2atom.find(group[k]);
+      if (it != name2atom.end() && added.insert(it->second).second)
+        result.push_back(it->second);
+    }
+  }
+  for (const auto& atom : base->order(formula, atoms)) {
+    if (added.find(atom) == added.end())
+      result.push_back(atom);
+  }
+  return result;
+}
+
+std::string InterleavedOrdering::signature() const {
+  std::string result = "interleaved(";
+  for (const auto& group : groups) {
+    result += "[";
+    for (const auto& name : group)
+      result += std::to_string(name.size()) + ":" + name;
+    result += "]";
+  }
+  return result + ";" + base->signature() + ")";
+}
+
+} // namespace whitemech::lydia
@@ -0,0 +1,212 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Concatenation and closure of MONA DFAs, built directly on the BDDs.
+ *
+ * Both operations are computed with a subset construction, in the style
+ * of MONA/DFA/project.c. The transitions of the operands are copied into
+ * a working manager, whose leaves are identifiers of sets of states;
+ * the transition BDD of a set is the union, leaf by leaf, of the BDDs
+ * of its elements. The epsilon moves (from a final state of the first
+ * operand to the initial state of the second one, or back to the initial
+ * state for the closure) are handled by closing the sets when they become
+ * states of the result.
+ */
+
+#include <lydia/mona_ext/mona_ext_base.hpp>
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+namespace whitemech::lydia {
+
+/* These global because used in the leaf functions.  */
+static bdd_manager* bddm_work;
+static std::map<std::vector<unsigned>, unsigned> set2id;
+static std::vector<std::vector<unsigned>> id2set;
+static std::vector<int> set_roots; /* index in bdd_roots(bddm_work) */
+static std::vector<bool> is_trigger; /* states with an epsilon move */
+static std::vector<bool> is_accepting;
+static unsigned epsilon_target;
+static std::map<unsigned, unsigned> closed2state;
+static std::vector<unsigned> state2set;
+static unsigned state_offset;
+
+static unsigned make_set(const std::vector<unsigned>& elements) {
+  auto it = set2id.find(elements);
+  if (it != set2id.end())
+    return it->second;
+  unsigned id = id2set.size();
+  set2id[elements] = id;
+  id2set.push_back(elements);
+  set_roots.push_back(-1);
+  return id;
+}
+
+/* Fn to map a state of an operand to its singleton */
+static unsigned copy_term(unsigned state) { return state + state_offset; }
+
+/* Fn to union leaves */
+static unsigned union_term(unsigned set_index1, unsigned set_index2) {
+  const auto& s1 = id2set[set_index1];
+  const auto& s2 = id2set[set_index2];
+  auto s = std::vector<unsigned>();
+  s.reserve(s1.size() + s2.size());
+  std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(),
+                 std::back_inserter(s));
+  return make_set(s);
+}
+
+/* Fn to close a set, and return the state of the result */
+static unsigned closed_term(unsigned set_index) {
+  auto s = id2set[set_index];
+  bool is_triggered = false;
+  for (auto e : s)
+    is_triggered = is_triggered || is_trigger[e];
+  if (is_triggered && !std::binary_search(s.begin(), s.end(), epsilon_target))
+    s.insert(std::lower_bound(s.begin(), s.end(), epsilon_target),
+             epsilon_target);
+  unsigned closed = make_set(s);
+  auto it = closed2state.find(closed);
+  if (it != closed2state.end())
+    return it->second;
+  unsigned state = state2set.size();
+  closed2state[closed] = state;
+  state2set.push_back(closed); /* Put in queue */
+  return state;
+}
+
+static unsigned eval_set(unsigned set_index) {
+  if (set_roots[set_index] == -1) {
+    // the BDD of a set is the union of the BDDs of its prefix and last state.
+    auto prefix = id2set[set_index];
+    unsigned last = prefix.back();
+    prefix.pop_back();
+    unsigned root1 = eval_set(make_set(prefix));
+    unsigned root2 = set_roots[last];
+    (void)bdd_apply2_hashed(bddm_work, bdd_roots(bddm_work)[root1], bddm_work,
+                            bdd_roots(bddm_work)[root2], bddm_work,
+                            &union_term);
+    set_roots[set_index] = bdd_roots_length(bddm_work) - 1;
+  }
+  return set_roots[set_index];
+}
+
+/*
+ * Subset construction on the disjoint union of the operands.
+ *
+ * The state i of the j-th operand is numbered offsets[j] + i.
+ * The globals is_trigger, is_accepting and epsilon_target must be set.
+ */
+static DFA* subset_construction(const std::vector<DFA*>& operands,
+                                unsigned initial_state) {
+  unsigned size_estimate = 8;
+  unsigned nb_states = 0;
+  for (auto a : operands) {
+    size_estimate += 2 * bdd_size(a->bddm);
+    nb_states += a->ns;
+  }
+  bddm_work = bdd_new_manager(size_estimate, size_estimate / 8 + 2);
+  bdd_make_cache(bddm_work, size_estimate, size_estimate / 8 + 2);
+  bddm_work->cache_erase_on_doubling = TRUE;
+  set2id.clear();
+  id2set.clear();
+  set_roots.clear();
+  closed2state.clear();
+  state2set.clear();
+
+  // singletons first, so that the singleton of state i has identifier i.
+  for (unsigned i = 0; i < nb_states; i++)
+    make_set({i});
+  state_offset = 0;
+  for (auto a : operands) {
+    bdd_prepare_apply1(a->bddm);
+    for (int i = 0; i < a->ns; i++) {
+      (void)bdd_apply1(a->bddm, a->q[i], bddm_work, &copy_term);
+      set_roots[state_offset + i] = bdd_roots_length(bddm_work) - 1;
+    }
+    state_offset += a->ns;
+  }
+  bdd_kill_cache(bddm_work);
+  bdd_make_cache(bddm_work, size_estimate, size_estimate / 8 + 2);
+  bddm_work->cache_erase_on_doubling = TRUE;
+
+  bdd_manager* bddm_res = bdd_new_manager(size_estimate, size_estimate / 8 + 2);
+  closed_term(initial_state); /* Should be 0 */
+  bdd_prepare_apply1(bddm_work);
+  for (size_t i = 0; i < state2set.size(); i++) {
+    unsigned root_place = eval_set(state2set[i]);
+    /* Insert leaves */
+    (void)bdd_apply1(bddm_work, bdd_roots(bddm_work)[root_place], bddm_res,
+                     &closed_term);
+  }
+
+  const int ns = state2set.size();
+  DFA* res = dfaMakeNoBddm(ns);
+  res->bddm = bddm_res;
+  res->s = 0;
+  for (int i = 0; i < ns; i++) {
+    res->q[i] = bdd_roots(bddm_res)[i];
+    bool is_final = false;
+    for (auto e : id2set[state2set[i]])
+      is_final = is_final || is_accepting[e];
+    res->f[i] = is_final ? 1 : -1;
+  }
+
+  bdd_update_statistics(bddm_work, (unsigned)PROJECT);
+  bdd_update_statistics(bddm_res, (unsigned)PROJECT);
+  bdd_kill_manager(bddm_work);
+  set2id.clear();
+  id2set.clear();
+  set_roots.clear();
+  closed2state.clear();
+  state2set.clear();
+  return res;
+}
+
+DFA* dfa_concatenate(DFA* a, DFA* b, int /*n*/, int* /*indices*/) {
+  const int ns1 = a->ns;
+  const int ns2 = b->ns;
+  is_trigger = std::vector<bool>(ns1 + ns2, false);
+  is_accepting = std::vector<bool>(ns1 + ns2, false);
+  for (int i = 0; i < ns1; i++)
+    is_trigger[i] = a->f[i] == 1;
+  for (int i = 0; i < ns2; i++)
+    is_accepting[ns1 + i] = b->f[i] == 1;
+  epsilon_target = ns1 + b->s;
+
+  DFA* tmp = subset_construction({a, b}, a->s);
+  DFA* result = dfaMinimize(tmp);
+  dfaFree(tmp);
+  return result;
+}
+
+DFA* dfa_closure(DFA* a, int /*n*/, int* /*indices*/) {
+  is_trigger = std::vector<bool>(a->ns, false);
+  for (int i = 0; i < a->ns; i++)
+    is_trigger[i] = a->f[i] == 1;
+  is_accepting = is_trigger;
+  epsilon_target = a->s;
+
+  DFA* tmp = subset_construction({a}, a->s);
+  DFA* result = dfaMinimize(tmp);
+  dfaFree(tmp);
+  return result;
+}
+
+} // namespace whitemech::lydia
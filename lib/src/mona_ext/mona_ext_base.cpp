@@ -16,6 +16,7 @@
  */
 
 #include <lydia/mona_ext/mona_ext_base.hpp>
+#include <unordered_set>
 
 namespace whitemech::lydia {
 
@@ -29,7 +30,51 @@ std::string get_path_guard(int n, trace_descr tp) {
   return std::string(result);
 }
 
-DFA* dfa_concatenate(DFA* a, DFA* b, int n, int* indices) {
+DFA* dfa_from_abstract_dfa(const abstract_dfa& automaton) {
+  const int ns = automaton.get_nb_states();
+  const int n = automaton.get_nb_variables();
+  const size_t nb_interpretations = size_t(1) << n;
+  auto indices = std::vector<int>(n);
+  std::iota(indices.begin(), indices.end(), 0);
+  std::string statuses;
+
+  dfaSetup(ns, n, indices.data());
+  auto symbol = interpretation_bits(n);
+  auto guard = std::string(n, '0');
+  auto successors = std::vector<int>(nb_interpretations);
+  for (int state = 0; state < ns; state++) {
+    // the most frequent successor is the default one.
+    std::map<int, size_t> counts;
+    for (size_t i = 0; i < nb_interpretations; i++) {
+      for (int j = 0; j < n; j++)
+        symbol.set(j, (i >> j) & 1);
+      successors[i] = automaton.get_successor(state, symbol);
+      counts[successors[i]]++;
+    }
+    auto default_successor =
+        std::max_element(counts.begin(), counts.end(),
+                         [](const auto& a, const auto& b) {
+                           return a.second < b.second;
+                         })
+            ->first;
+    dfaAllocExceptions(nb_interpretations - counts[default_successor]);
+    for (size_t i = 0; i < nb_interpretations; i++) {
+      if (successors[i] == default_successor)
+        continue;
+      for (int j = 0; j < n; j++)
+        guard[j] = ((i >> j) & 1) ? '1' : '0';
+      dfaStoreException(successors[i], guard.data());
+    }
+    dfaStoreState(default_successor);
+    statuses += automaton.is_final(state) ? "+" : "-";
+  }
+  // dfaBuild makes state 0 initial, which is not always the case.
+  DFA* result = dfaBuild(statuses.data());
+  result->s = automaton.get_initial_state();
+  return result;
+}
+
+DFA* dfa_concatenate_with_guards(DFA* a, DFA* b, int n, int* indices) {
   DFA* result;
   DFA* tmp;
   paths state_paths, pp;
@@ -133,7 +178,7 @@ DFA* dfa_concatenate(DFA* a, DFA* b, int n, int* indices) {
   return result;
 }
 
-DFA* dfa_closure(DFA* a, int n, int* indices) {
+DFA* dfa_closure_with_guards(DFA* a, int n, int* indices) {
   DFA* result;
   DFA* tmp;
   paths state_paths, pp;
@@ -484,9 +529,40 @@ void dfaPrint(DFA* a, int no_free_vars, std::vector<std::string> free_variables,
 }
 
 bool is_sink(DFA* automaton, bool is_positive) {
-  bool has_one_state = automaton->ns == 1;
-  bool is_initial_state_final = automaton->f[0] == 1;
-  return has_one_state and (is_initial_state_final == is_positive);
+  if (automaton->ns == 1)
+    return (automaton->f[0] == 1) == is_positive;
+
+  // the DFA may not be minimized: visit the states reachable from the
+  // initial one, and stop at the first one with the wrong status.
+  bdd_manager* bddm = automaton->bddm;
+  auto reached = std::vector<bool>(automaton->ns, false);
+  auto visited_nodes = std::unordered_set<bdd_ptr>();
+  auto states = std::vector<int>{automaton->s};
+  auto nodes = std::vector<bdd_ptr>();
+  reached[automaton->s] = true;
+  while (!states.empty()) {
+    int state = states.back();
+    states.pop_back();
+    if ((automaton->f[state] == 1) != is_positive)
+      return false;
+    nodes.push_back(automaton->q[state]);
+    while (!nodes.empty()) {
+      bdd_ptr p = nodes.back();
+      nodes.pop_back();
+      if (!visited_nodes.insert(p).second)
+        continue;
+      unsigned l, r, index;
+      LOAD_lri(&bddm->node_table[p], l, r, index);
+      if (index != BDD_LEAF_INDEX) {
+        nodes.push_back(l);
+        nodes.push_back(r);
+      } else if (!reached[l]) {
+        reached[l] = true;
+        states.push_back(l);
+      }
+    }
+  }
+  return true;
 }
 
 } // namespace whitemech::lydia
\ No newline at end of file
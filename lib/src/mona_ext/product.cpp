@@ -0,0 +1,180 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * N-ary synchronous product of MONA DFAs.
+ *
+ * It follows the structure of MONA/DFA/product.c: the states of the
+ * product are discovered by the leaf function of bdd_apply2_hashed.
+ * The transition BDD of a tuple (s_0, ..., s_{k-1}) is computed with
+ * a chain of k-1 applications: the leaves of the intermediate BDDs
+ * are identifiers of the partial tuples (s_0, ..., s_j).
+ * Each step of the chain has its own result manager, so that the
+ * apply cache of a manager is always used with the same operands.
+ */
+
+#include <lydia/mona_ext/mona_ext_base.hpp>
+#include <map>
+#include <stdexcept>
+
+namespace whitemech::lydia {
+
+/* These global because used in the leaf function.  */
+static std::vector<int> dominant_sinks;
+static std::map<std::vector<unsigned>, unsigned> partial2id;
+static std::vector<std::vector<unsigned>> id2partial;
+static std::map<std::vector<unsigned>, unsigned> tuple2state;
+static std::vector<std::vector<unsigned>> state2tuple;
+static int sink_state;
+static size_t current_step;
+static bool is_last_step;
+
+/*
+ * Check whether the state only loops on itself.
+ */
+static bool is_sink_state(DFA* a, int state) {
+  unsigned l, r, index;
+  LOAD_lri(&a->bddm->node_table[a->q[state]], l, r, index);
+  return index == BDD_LEAF_INDEX && l == (unsigned)state;
+}
+
+static unsigned make_state(const std::vector<unsigned>& tuple) {
+  // a tuple with a component in a dominant sink is collapsed into one state.
+  bool is_dominated = false;
+  for (size_t j = 0; j < tuple.size() && !is_dominated; j++)
+    is_dominated = dominant_sinks[j] == (int)tuple[j];
+  if (is_dominated && sink_state != -1)
+    return sink_state;
+
+  auto it = tuple2state.find(tuple);
+  if (it != tuple2state.end())
+    return it->second;
+  unsigned id = state2tuple.size();
+  tuple2state[tuple] = id;
+  state2tuple.push_back(tuple);
+  if (is_dominated)
+    sink_state = id;
+  return id;
+}
+
+static unsigned make_partial(std::vector<unsigned>&& partial) {
+  auto it = partial2id.find(partial);
+  if (it != partial2id.end())
+    return it->second;
+  unsigned id = id2partial.size();
+  partial2id[partial] = id;
+  id2partial.push_back(std::move(partial));
+  return id;
+}
+
+/* Fn to extend a partial tuple with a state of the next automaton. */
+static unsigned nary_term(unsigned left, unsigned right) {
+  std::vector<unsigned> tuple;
+  if (current_step == 1)
+    tuple = {left};
+  else
+    tuple = id2partial[left];
+  tuple.push_back(right);
+  if (is_last_step)
+    return make_state(tuple);
+  return make_partial(std::move(tuple));
+}
+
+DFA* dfa_nary_product(const std::vector<DFA*>& dfas, dfaProductType type) {
+  if (type != dfaAND && type != dfaOR)
+    throw std::invalid_argument("Only conjunction and disjunction supported.");
+  if (dfas.empty())
+    throw std::invalid_argument("At least one automaton is required.");
+  if (dfas.size() == 1)
+    return dfaCopy(dfas[0]);
+
+  const bool is_and = type == dfaAND;
+  const size_t k = dfas.size();
+  unsigned size_estimate = 0;
+  dominant_sinks = std::vector<int>(k, -1);
+  for (size_t j = 0; j < k; j++) {
+    size_estimate += bdd_size(dfas[j]->bddm);
+    // rejecting sinks dominate conjunctions, accepting sinks disjunctions.
+    for (int s = 0; s < dfas[j]->ns; s++) {
+      if ((dfas[j]->f[s] == 1) != is_and && is_sink_state(dfas[j], s)) {
+        dominant_sinks[j] = s;
+        break;
+      }
+    }
+  }
+  size_estimate = 2 * size_estimate + 8;
+  partial2id.clear();
+  id2partial.clear();
+  tuple2state.clear();
+  state2tuple.clear();
+  sink_state = -1;
+
+  // one result manager per step of the chain; the last one is the result.
+  auto managers = std::vector<bdd_manager*>(k);
+  for (size_t j = 1; j < k; j++) {
+    managers[j] = bdd_new_manager(size_estimate, size_estimate / 8 + 2);
+    bdd_make_cache(managers[j], size_estimate, size_estimate / 8 + 2);
+    managers[j]->cache_erase_on_doubling = TRUE;
+  }
+  bdd_manager* bddm_res = managers[k - 1];
+
+  auto initial_tuple = std::vector<unsigned>(k);
+  for (size_t j = 0; j < k; j++)
+    initial_tuple[j] = dfas[j]->s;
+  make_state(initial_tuple); /* Should be 0 */
+
+  // BFS: new states are appended to state2tuple by the leaf function.
+  for (size_t i = 0; i < state2tuple.size(); i++) {
+    const std::vector<unsigned> tuple = state2tuple[i];
+    bdd_manager* left_bddm = dfas[0]->bddm;
+    bdd_ptr left = dfas[0]->q[tuple[0]];
+    for (size_t j = 1; j < k; j++) {
+      current_step = j;
+      is_last_step = j == k - 1;
+      (void)bdd_apply2_hashed(left_bddm, left, dfas[j]->bddm,
+                              dfas[j]->q[tuple[j]], managers[j], &nary_term);
+      left_bddm = managers[j];
+      left = bdd_roots(managers[j])[bdd_roots_length(managers[j]) - 1];
+    }
+  }
+
+  const int ns = state2tuple.size();
+  DFA* result = dfaMakeNoBddm(ns);
+  result->bddm = bddm_res;
+  result->s = 0;
+  for (int i = 0; i < ns; i++) {
+    result->q[i] = bdd_roots(bddm_res)[i];
+    bool is_final = is_and;
+    for (size_t j = 0; j < k; j++) {
+      bool is_component_final = dfas[j]->f[state2tuple[i][j]] == 1;
+      is_final = is_and ? is_final && is_component_final
+                        : is_final || is_component_final;
+    }
+    result->f[i] = is_final ? 1 : -1;
+  }
+
+  for (size_t j = 1; j < k - 1; j++)
+    bdd_kill_manager(managers[j]);
+  bdd_update_statistics(bddm_res, (unsigned)PRODUCT);
+  partial2id.clear();
+  id2partial.clear();
+  tuple2state.clear();
+  state2tuple.clear();
+  return result;
+}
+
+} // namespace whitemech::lydia
@@ -0,0 +1,148 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <climits>
+#include <lydia/dfa/classification.hpp>
+#include <lydia/monitor/batch.hpp>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace whitemech::lydia {
+
+MonitorBatch::MonitorBatch(const compiled_dfa& automaton, size_t nb_instances)
+    : nb_variables_{automaton.get_nb_variables()},
+      initial_state_(automaton.get_initial_state()),
+      states_(nb_instances, automaton.get_initial_state()),
+      finals_(nb_instances), sinks_(nb_instances) {
+  const size_t nb_states = automaton.get_nb_states();
+  const uint32_t nb_symbols = 1u << nb_variables_;
+  // the indices of the gathers are signed 32-bit integers.
+  if (nb_states * nb_symbols > (size_t)INT_MAX)
+    throw std::invalid_argument("the transition table is too large");
+
+  table_.resize(nb_states * nb_symbols);
+  std::vector<std::vector<int>> successors(nb_states);
+  std::vector<bool> finals(nb_states);
+  for (size_t s = 0; s < nb_states; s++) {
+    for (uint32_t symbol = 0; symbol < nb_symbols; symbol++) {
+      int successor = automaton.get_successor(s, symbol);
+      table_[(s << nb_variables_) | symbol] = successor;
+      successors[s].push_back(successor);
+    }
+    std::sort(successors[s].begin(), successors[s].end());
+    successors[s].erase(
+        std::unique(successors[s].begin(), successors[s].end()),
+        successors[s].end());
+    finals[s] = automaton.is_final(s);
+  }
+
+  auto classification = classify_states(successors, finals);
+  status_.resize(nb_states, 0);
+  for (size_t s = 0; s < nb_states; s++) {
+    if (finals[s])
+      status_[s] |= FINAL;
+    if (!classification.is_live(s))
+      status_[s] |= SINK;
+  }
+  update_verdicts_();
+}
+
+void MonitorBatch::update_verdicts_() {
+  const size_t n = states_.size();
+  for (size_t w = 0; w * 64 < n; w++) {
+    uint64_t final_word = 0;
+    uint64_t sink_word = 0;
+    for (size_t i = w * 64; i < std::min(n, w * 64 + 64); i++) {
+      uint32_t status = status_[states_[i]];
+      final_word |= uint64_t(status & FINAL) << (i & 63);
+      sink_word |= uint64_t((status & SINK) >> 1) << (i & 63);
+    }
+    finals_.set_word(w, final_word);
+    sinks_.set_word(w, sink_word);
+  }
+}
+
+void MonitorBatch::step(const uint32_t* symbols) {
+  const size_t n = states_.size();
+  uint32_t* states = states_.data();
+  for (size_t w = 0; w * 64 < n; w++) {
+    const size_t begin = w * 64;
+    const size_t end = std::min(n, begin + 64);
+    uint64_t final_word = 0;
+    uint64_t sink_word = 0;
+    size_t i = begin;
+#if defined(__AVX2__)
+    const auto* table = reinterpret_cast<const int*>(table_.data());
+    const auto* status = reinterpret_cast<const int*>(status_.data());
+    const __m128i shift = _mm_cvtsi32_si128(nb_variables_);
+    for (; i + 8 <= end; i += 8) {
+      __m256i current =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states + i));
+      __m256i symbol =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(symbols + i));
+      __m256i index = _mm256_or_si256(_mm256_sll_epi32(current, shift), symbol);
+      __m256i next = _mm256_i32gather_epi32(table, index, 4);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(states + i), next);
+      // move the FINAL and SINK bits to the sign bits.
+      __m256i flags = _mm256_i32gather_epi32(status, next, 4);
+      auto finals = _mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_slli_epi32(flags, 31)));
+      auto sinks = _mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_slli_epi32(flags, 30)));
+      final_word |= uint64_t(finals) << (i - begin);
+      sink_word |= uint64_t(sinks) << (i - begin);
+    }
+#endif
+    for (; i < end; i++) {
+      states[i] = table_[(states[i] << nb_variables_) | symbols[i]];
+      uint32_t status = status_[states[i]];
+      final_word |= uint64_t(status & FINAL) << (i - begin);
+      sink_word |= uint64_t((status & SINK) >> 1) << (i - begin);
+    }
+    finals_.set_word(w, final_word);
+    sinks_.set_word(w, sink_word);
+  }
+}
+
+void MonitorBatch::step(const std::vector<uint32_t>& symbols) {
+  if (symbols.size() != states_.size())
+    throw std::invalid_argument("one interpretation per instance expected");
+  step(symbols.data());
+}
+
+void MonitorBatch::reset() {
+  std::fill(states_.begin(), states_.end(), initial_state_);
+  update_verdicts_();
+}
+
+void MonitorBatch::reset(size_t instance) {
+  states_[instance] = initial_state_;
+  uint32_t status = status_[initial_state_];
+  if (status & FINAL)
+    finals_.set(instance);
+  else
+    finals_.unset(instance);
+  if (status & SINK)
+    sinks_.set(instance);
+  else
+    sinks_.unset(instance);
+}
+
+} // namespace whitemech::lydia
@@ -0,0 +1,165 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cassert>
+#include <lydia/logic/atom_visitor.hpp>
+#include <lydia/logic/nnf.hpp>
+#include <lydia/logic/pl/eval.hpp>
+#include <lydia/logic/to_ldlf.hpp>
+#include <lydia/monitor/progression.hpp>
+#include <lydia/to_dfa/delta.hpp>
+#include <lydia/visitor.hpp>
+
+namespace whitemech::lydia {
+
+/*!
+ * Turn the output of delta into an LDLf formula, replacing every
+ * quoted formula with the formula itself.
+ */
+class UnquoteVisitor : public Visitor {
+private:
+  AstManager& context_;
+  ldlf_ptr result;
+
+public:
+  explicit UnquoteVisitor(AstManager& context) : context_{context} {}
+
+  void visit(const PropositionalTrue&) override {
+    result = context_.makeLdlfTrue();
+  }
+  void visit(const PropositionalFalse&) override {
+    result = context_.makeLdlfFalse();
+  }
+  void visit(const PropositionalAtom& x) override {
+    const auto& quoted = dynamic_cast<const QuotedFormula&>(*x.symbol);
+    result = std::static_pointer_cast<const LDLfFormula>(quoted.formula);
+  }
+  void visit(const PropositionalAnd& x) override {
+    set_formulas args;
+    for (const auto& arg : x.get_container())
+      args.insert(apply(*arg));
+    result = context_.makeLdlfAnd(args);
+  }
+  void visit(const PropositionalOr& x) override {
+    set_formulas args;
+    for (const auto& arg : x.get_container())
+      args.insert(apply(*arg));
+    result = context_.makeLdlfOr(args);
+  }
+  void visit(const PropositionalNot&) override {
+    throw std::logic_error("delta should not produce negations");
+  }
+
+  ldlf_ptr apply(const PropositionalFormula& x) {
+    x.accept(*this);
+    return result;
+  }
+};
+
+std::string to_string(MonitorVerdict verdict) {
+  switch (verdict) {
+  case MonitorVerdict::permanently_true:
+    return "permanently_true";
+  case MonitorVerdict::permanently_false:
+    return "permanently_false";
+  case MonitorVerdict::presumably_true:
+    return "presumably_true";
+  case MonitorVerdict::presumably_false:
+    return "presumably_false";
+  }
+  throw std::invalid_argument("unknown verdict");
+}
+
+ProgressionMonitor::ProgressionMonitor(const LDLfFormula& formula)
+    : initial_formula_{to_nnf(formula)}, formula_{initial_formula_} {
+  auto atoms = find_atoms(*initial_formula_);
+  id2atoms_ = std::vector<atom_ptr>(atoms.begin(), atoms.end());
+  verdict_ = compute_verdict_(formula_);
+}
+
+ProgressionMonitor::ProgressionMonitor(const LTLfFormula& formula)
+    : ProgressionMonitor(*to_ldlf(formula)) {}
+
+MonitorVerdict ProgressionMonitor::compute_verdict_(const ldlf_ptr& formula) {
+  auto it = verdicts_.find(formula);
+  if (it != verdicts_.end())
+    return it->second;
+  MonitorVerdict result;
+  if (is_a<LDLfTrue>(*formula))
+    result = MonitorVerdict::permanently_true;
+  else if (is_a<LDLfFalse>(*formula))
+    result = MonitorVerdict::permanently_false;
+  else if (eval(*delta(*formula), set_atoms_ptr{}))
+    result = MonitorVerdict::presumably_true;
+  else
+    result = MonitorVerdict::presumably_false;
+  verdicts_.emplace(formula, result);
+  return result;
+}
+
+void ProgressionMonitor::step_(const std::vector<bool>& key) {
+  ++nb_steps_;
+  auto it = progressions_.find({formula_, key});
+  if (it == progressions_.end()) {
+    set_atoms_ptr true_atoms;
+    for (size_t i = 0; i < id2atoms_.size(); i++)
+      if (key[i])
+        true_atoms.insert(id2atoms_[i]);
+    auto unquote = UnquoteVisitor(formula_->ctx());
+    auto next = unquote.apply(*delta(*formula_, true_atoms));
+    it = progressions_.emplace(std::make_pair(formula_, key), next).first;
+  }
+  formula_ = it->second;
+  verdict_ = compute_verdict_(formula_);
+}
+
+MonitorVerdict ProgressionMonitor::step(const set_atoms_ptr& true_atoms) {
+  if (is_permanent())
+    return verdict_;
+  auto key = std::vector<bool>(id2atoms_.size());
+  for (size_t i = 0; i < id2atoms_.size(); i++)
+    key[i] = true_atoms.find(id2atoms_[i]) != true_atoms.end();
+  step_(key);
+  return verdict_;
+}
+
+MonitorVerdict ProgressionMonitor::step(const interpretation& symbol) {
+  if (is_permanent())
+    return verdict_;
+  assert(symbol.size() >= id2atoms_.size());
+  auto key = std::vector<bool>(id2atoms_.size());
+  for (size_t i = 0; i < id2atoms_.size(); i++)
+    key[i] = symbol[i];
+  step_(key);
+  return verdict_;
+}
+
+MonitorVerdict ProgressionMonitor::run(const trace& word) {
+  for (const auto& symbol : word) {
+    if (is_permanent())
+      break;
+    step(symbol);
+  }
+  return verdict_;
+}
+
+void ProgressionMonitor::reset() {
+  formula_ = initial_formula_;
+  nb_steps_ = 0;
+  verdict_ = compute_verdict_(formula_);
+}
+
+} // namespace whitemech::lydia
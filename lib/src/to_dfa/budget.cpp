@@ -0,0 +1,89 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <lydia/to_dfa/budget.hpp>
+
+namespace whitemech::lydia {
+
+static std::string violation_to_string(BudgetViolation violation) {
+  switch (violation) {
+  case BudgetViolation::cancelled:
+    return "translation cancelled";
+  case BudgetViolation::deadline:
+    return "deadline exceeded";
+  case BudgetViolation::dfa_states:
+    return "maximum number of DFA states exceeded";
+  case BudgetViolation::bdd_nodes:
+    return "maximum number of BDD nodes exceeded";
+  }
+  return "budget exceeded";
+}
+
+budget_exceeded_error::budget_exceeded_error(
+    BudgetViolation violation, const TranslationStatistics& statistics)
+    : std::runtime_error(violation_to_string(violation)),
+      violation{violation}, statistics{statistics} {}
+
+TranslationBudget&
+TranslationBudget::set_timeout(std::chrono::milliseconds timeout) {
+  timeout_ = timeout;
+  return *this;
+}
+
+TranslationBudget&
+TranslationBudget::set_max_dfa_states(size_t max_dfa_states) {
+  max_dfa_states_ = max_dfa_states;
+  return *this;
+}
+
+TranslationBudget& TranslationBudget::set_max_bdd_nodes(size_t max_bdd_nodes) {
+  max_bdd_nodes_ = max_bdd_nodes;
+  return *this;
+}
+
+void TranslationBudget::start() {
+  statistics_ = TranslationStatistics();
+  start_ = std::chrono::steady_clock::now();
+}
+
+void TranslationBudget::fail_(BudgetViolation violation) {
+  throw budget_exceeded_error(violation, statistics_);
+}
+
+void TranslationBudget::check() {
+  ++statistics_.nb_checks;
+  statistics_.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_);
+  if (cancelled_)
+    fail_(BudgetViolation::cancelled);
+  if (timeout_.count() > 0 && statistics_.elapsed > timeout_)
+    fail_(BudgetViolation::deadline);
+}
+
+void TranslationBudget::check(size_t nb_states, size_t nb_bdd_nodes) {
+  ++statistics_.nb_intermediate_dfas;
+  statistics_.max_dfa_states = std::max(statistics_.max_dfa_states, nb_states);
+  statistics_.max_bdd_nodes = std::max(statistics_.max_bdd_nodes, nb_bdd_nodes);
+  check();
+  if (max_dfa_states_ > 0 && nb_states > max_dfa_states_)
+    fail_(BudgetViolation::dfa_states);
+  if (max_bdd_nodes_ > 0 && nb_bdd_nodes > max_bdd_nodes_)
+    fail_(BudgetViolation::bdd_nodes);
+}
+
+} // namespace whitemech::lydia
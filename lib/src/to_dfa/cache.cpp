@@ -0,0 +1,231 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <lydia/dfa/binary_format.hpp>
+#include <lydia/dfa/dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <lydia/logic/nnf.hpp>
+#include <lydia/mona_ext/mona_ext_base.hpp>
+#include <lydia/to_dfa/cache.hpp>
+#include <lydia/utils/mapped_file.hpp>
+#include <lydia/utils/print.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace whitemech::lydia {
+
+Logger TranslationCache::logger = Logger("cache");
+
+static const char* const ENTRY_EXTENSION = ".ldfa";
+
+/*
+ * 64-bit FNV-1a: unlike std::hash, it is the same on every platform.
+ */
+static std::uint64_t fnv1a(const std::string& s) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : s) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/*
+ * A minimized MONA DFA equivalent to the given DFA.
+ */
+static std::unique_ptr<mona_dfa> minimized(const abstract_dfa& automaton) {
+  DFA* a;
+  std::vector<std::string> names;
+  std::vector<unsigned> indices;
+  if (auto m = dynamic_cast<const mona_dfa*>(&automaton)) {
+    a = dfaMinimize(m->dfa_);
+    names = m->names;
+    indices = m->indices;
+  } else if (auto d = dynamic_cast<const dfa*>(&automaton)) {
+    std::stringstream stream;
+    write_binary_dfa(stream, *d);
+    auto content = stream.str();
+    auto file =
+        parse_binary_dfa(content.data(), content.data() + content.size());
+    DFA* tmp = mona_dfa_from_file(file);
+    a = dfaMinimize(tmp);
+    dfaFree(tmp);
+    names = file.variables;
+  } else {
+    DFA* tmp = dfa_from_abstract_dfa(automaton);
+    a = dfaMinimize(tmp);
+    dfaFree(tmp);
+    for (int i = 0; i < automaton.get_nb_variables(); i++)
+      names.push_back(std::to_string(i));
+  }
+  auto result = std::make_unique<mona_dfa>(a, names);
+  if (!indices.empty())
+    result->indices = indices;
+  return result;
+}
+
+static void write_uint32(std::ostream& out, std::uint32_t value) {
+  char bytes[4] = {static_cast<char>(value & 0xFF),
+                   static_cast<char>((value >> 8) & 0xFF),
+                   static_cast<char>((value >> 16) & 0xFF),
+                   static_cast<char>((value >> 24) & 0xFF)};
+  out.write(bytes, 4);
+}
+
+TranslationCache::TranslationCache(const std::string& directory,
+                                   std::uintmax_t max_size)
+    : directory_{directory}, max_size_{max_size} {
+  std::filesystem::create_directories(directory_);
+}
+
+std::string TranslationCache::make_key(const LDLfFormula& formula,
+                                       const Strategy& strategy) {
+  auto signature = strategy.signature();
+  if (signature.empty())
+    return "";
+  return signature + "\n" + to_string(*to_nnf(formula));
+}
+
+std::filesystem::path
+TranslationCache::entry_path_(const std::string& key) const {
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016llx",
+                static_cast<unsigned long long>(fnv1a(key)));
+  return directory_ / (std::string(name) + ENTRY_EXTENSION);
+}
+
+std::shared_ptr<abstract_dfa>
+TranslationCache::lookup(const std::string& key, const Strategy& strategy) {
+  auto path = entry_path_(key);
+  std::error_code ec;
+  if (!std::filesystem::exists(path, ec)) {
+    ++statistics_.nb_misses;
+    return nullptr;
+  }
+
+  std::shared_ptr<abstract_dfa> result;
+  try {
+    MappedFile entry(path.string());
+    const auto* bytes = reinterpret_cast<const unsigned char*>(entry.begin());
+    if (entry.size() < 4)
+      throw std::runtime_error("Truncated cache entry.");
+    std::uint32_t key_size = (std::uint32_t)bytes[0] |
+                             ((std::uint32_t)bytes[1] << 8) |
+                             ((std::uint32_t)bytes[2] << 16) |
+                             ((std::uint32_t)bytes[3] << 24);
+    const char* dfa_begin = entry.begin() + 4 + key_size;
+    if (entry.size() < 4 + (size_t)key_size)
+      throw std::runtime_error("Truncated cache entry.");
+    if (key_size != key.size() ||
+        std::memcmp(entry.begin() + 4, key.data(), key_size) != 0) {
+      // a collision: the entry will be replaced by the next store.
+      logger.debug("hash collision on {}", path.string());
+      ++statistics_.nb_misses;
+      return nullptr;
+    }
+    result = strategy.load(parse_binary_dfa(dfa_begin, entry.end()));
+  } catch (const std::runtime_error& e) {
+    logger.info("discarding cache entry {}: {}", path.string(), e.what());
+    std::filesystem::remove(path, ec);
+    ++statistics_.nb_invalid;
+    ++statistics_.nb_misses;
+    return nullptr;
+  }
+
+  std::filesystem::last_write_time(
+      path, std::filesystem::file_time_type::clock::now(), ec);
+  ++statistics_.nb_hits;
+  return result;
+}
+
+void TranslationCache::store(const std::string& key,
+                             const abstract_dfa& automaton) {
+  auto path = entry_path_(key);
+  // write to a temporary file, then rename it: concurrent readers
+  // never see a partial entry.
+  auto tmp_path = path;
+  tmp_path += ".tmp" + std::to_string(getpid());
+  try {
+    {
+      std::ofstream out(tmp_path, std::ios::binary);
+      if (!out)
+        throw std::runtime_error("Cannot open file: " + tmp_path.string());
+      write_uint32(out, key.size());
+      out.write(key.data(), key.size());
+      write_binary_dfa(out, *minimized(automaton));
+      out.flush();
+      if (!out.good())
+        throw std::runtime_error("Cannot write file: " + tmp_path.string());
+    }
+    std::filesystem::rename(tmp_path, path);
+  } catch (const std::runtime_error& e) {
+    logger.info("cannot store cache entry {}: {}", path.string(), e.what());
+    std::error_code ec;
+    std::filesystem::remove(tmp_path, ec);
+    ++statistics_.nb_failed_stores;
+    throw;
+  }
+  ++statistics_.nb_stores;
+  evict_();
+}
+
+std::uintmax_t TranslationCache::get_size() const {
+  std::uintmax_t size = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+    if (entry.path().extension() == ENTRY_EXTENSION)
+      size += entry.file_size();
+  }
+  return size;
+}
+
+void TranslationCache::evict_() {
+  std::vector<std::filesystem::directory_entry> entries;
+  std::uintmax_t size = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+    if (entry.path().extension() != ENTRY_EXTENSION)
+      continue;
+    entries.push_back(entry);
+    size += entry.file_size();
+  }
+  if (size <= max_size_)
+    return;
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return a.last_write_time() < b.last_write_time();
+  });
+  std::error_code ec;
+  for (const auto& entry : entries) {
+    if (size <= max_size_)
+      break;
+    size -= entry.file_size();
+    std::filesystem::remove(entry.path(), ec);
+    ++statistics_.nb_evictions;
+  }
+}
+
+void TranslationCache::clear() {
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+    if (entry.path().extension() == ENTRY_EXTENSION)
+      std::filesystem::remove(entry.path(), ec);
+  }
+}
+
+} // namespace whitemech::lydia
@@ -15,7 +15,10 @@
  * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <lydia/dfa/binary_format.hpp>
 #include <lydia/dfa/dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <lydia/to_dfa/cache.hpp>
 #include <lydia/to_dfa/core.hpp>
 #include <lydia/to_dfa/strategies/bdd/base.hpp>
 #include <lydia/to_dfa/strategies/compositional/base.hpp>
@@ -24,6 +27,44 @@
 
 namespace whitemech::lydia {
 
+std::shared_ptr<abstract_dfa> Strategy::load(const MonaDFAFile& file) const {
+  return std::make_shared<mona_dfa>(mona_dfa_from_file(file), file.variables);
+}
+
+std::shared_ptr<abstract_dfa> Translator::to_dfa(const LDLfFormula& f) const {
+  if (cache == nullptr)
+    return translate_(f);
+  auto key = TranslationCache::make_key(f, strategy);
+  if (key.empty())
+    return translate_(f);
+  auto result = cache->lookup(key, strategy);
+  if (result)
+    return result;
+  result = translate_(f);
+  // the translation succeeded anyway: a failed store is only counted in
+  // the statistics of the cache.
+  try {
+    cache->store(key, *result);
+  } catch (const std::runtime_error&) {
+  }
+  return result;
+}
+
+std::shared_ptr<abstract_dfa>
+Translator::translate_(const LDLfFormula& f) const {
+  if (budget)
+    budget->start();
+  strategy.set_budget(budget);
+  try {
+    auto result = strategy.to_dfa(f);
+    strategy.set_budget(nullptr);
+    return result;
+  } catch (...) {
+    strategy.set_budget(nullptr);
+    throw;
+  }
+}
+
 std::shared_ptr<abstract_dfa> to_dfa_with_strategy(const LDLfFormula& formula,
                                                    Strategy& s) {
   auto t = Translator(s);
@@ -48,11 +48,16 @@ bool DFAState::is_equal(const Basic& rhs) const {
 }
 
 bool DFAState::is_final() const {
+  if (is_final_ != -1)
+    return is_final_;
+  is_final_ = 0;
   for (const auto& nfa_state : states) {
-    if (nfa_state->is_final())
-      return true;
+    if (nfa_state->is_final()) {
+      is_final_ = 1;
+      break;
+    }
   }
-  return false;
+  return is_final_;
 }
 
 } // namespace whitemech::lydia
\ No newline at end of file
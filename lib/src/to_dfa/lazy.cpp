@@ -0,0 +1,89 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cassert>
+#include <lydia/logic/atom_visitor.hpp>
+#include <lydia/logic/nnf.hpp>
+#include <lydia/to_dfa/lazy.hpp>
+#include <lydia/to_dfa/strategies/naive.hpp>
+
+namespace whitemech::lydia {
+
+LazyDFA::LazyDFA(const LDLfFormula& formula, size_t max_cached_states)
+    : formula_{to_nnf(formula)},
+      max_cached_states_{std::max<size_t>(max_cached_states, 1)} {
+  auto atoms = find_atoms(*formula_);
+  id2atoms_ = std::vector<atom_ptr>(atoms.begin(), atoms.end());
+  initial_state_ =
+      std::make_shared<DFAState>(formula_->ctx(), set_formulas{formula_});
+  intern_(initial_state_);
+}
+
+std::list<LazyDFA::Entry>::iterator
+LazyDFA::intern_(const dfa_state_ptr& state) {
+  auto it = index_.find(state);
+  if (it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second;
+  }
+  entries_.push_front(Entry{state, {}});
+  index_.emplace(state, entries_.begin());
+  return entries_.begin();
+}
+
+void LazyDFA::shrink_() {
+  while (entries_.size() > max_cached_states_) {
+    index_.erase(entries_.back().state);
+    entries_.pop_back();
+    ++statistics_.nb_evictions;
+  }
+}
+
+dfa_state_ptr LazyDFA::get_successor(const dfa_state_ptr& state,
+                                     const interpretation& symbol) {
+  assert(symbol.size() >= id2atoms_.size());
+  auto key = std::vector<bool>(id2atoms_.size());
+  for (size_t i = 0; i < id2atoms_.size(); i++)
+    key[i] = symbol[i];
+
+  auto entry = intern_(state);
+  auto it = entry->successors.find(key);
+  if (it != entry->successors.end()) {
+    ++statistics_.nb_hits;
+    return it->second;
+  }
+  ++statistics_.nb_misses;
+
+  set_atoms_ptr true_atoms;
+  for (size_t i = 0; i < id2atoms_.size(); i++)
+    if (key[i])
+      true_atoms.insert(id2atoms_[i]);
+  auto successor = NaiveStrategy::next_state(*entry->state, true_atoms);
+  // return the interned copy, which carries the memoized transitions.
+  successor = intern_(successor)->state;
+  entry->successors.emplace(std::move(key), successor);
+  shrink_();
+  return successor;
+}
+
+bool LazyDFA::accepts(const trace& word) {
+  auto current = initial_state_;
+  for (const auto& symbol : word)
+    current = get_successor(current, symbol);
+  return is_final(current);
+}
+
+} // namespace whitemech::lydia
@@ -42,6 +42,12 @@ hash_t NFAState::compute_hash_() const {
 }
 
 bool NFAState::is_final() const {
+  if (is_final_ == -1)
+    is_final_ = compute_is_final_();
+  return is_final_;
+}
+
+bool NFAState::compute_is_final_() const {
   // This will be put in conjunction with other formulas
   vec_prop_formulas args{context.makeTrue(), context.makeTrue()};
   for (const auto& formula : formulas) {
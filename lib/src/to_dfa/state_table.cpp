@@ -0,0 +1,140 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <lydia/to_dfa/state_table.hpp>
+
+namespace whitemech::lydia {
+
+// a slot contains the index of the entry plus one; zero means empty.
+static const size_t EMPTY_SLOT = 0;
+
+static size_t next_power_of_two(size_t n) {
+  size_t result = 1;
+  while (result < n)
+    result <<= 1;
+  return result;
+}
+
+StateTable::StateTable(size_t initial_capacity)
+    : slots_(next_power_of_two(std::max<size_t>(initial_capacity, 2)),
+             EMPTY_SLOT),
+      nfa_slots_(next_power_of_two(std::max<size_t>(initial_capacity, 2)),
+                 EMPTY_SLOT) {}
+
+size_t StateTable::probe_(hash_t hash) const {
+  const size_t mask = slots_.size() - 1;
+  size_t i = hash & mask;
+  while (slots_[i] != EMPTY_SLOT) {
+    const Entry& entry = entries_[slots_[i] - 1];
+    if (entry.hash == hash && entry.key_size == key_buffer_.size() &&
+        std::equal(key_buffer_.begin(), key_buffer_.end(),
+                   keys_.begin() + entry.key_begin))
+      return i;
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+size_t StateTable::probe_nfa_(const NFAState& state) const {
+  const size_t mask = nfa_slots_.size() - 1;
+  const hash_t hash = state.hash();
+  size_t i = hash & mask;
+  while (nfa_slots_[i] != EMPTY_SLOT) {
+    const NFAState& other = *nfa_states_[nfa_slots_[i] - 1];
+    if (other.hash() == hash && eq(other, state))
+      return i;
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+void StateTable::rehash_() {
+  std::vector<size_t> new_slots(slots_.size() * 2, EMPTY_SLOT);
+  const size_t mask = new_slots.size() - 1;
+  for (size_t k = 0; k < entries_.size(); k++) {
+    size_t i = entries_[k].hash & mask;
+    while (new_slots[i] != EMPTY_SLOT)
+      i = (i + 1) & mask;
+    new_slots[i] = k + 1;
+  }
+  slots_ = std::move(new_slots);
+}
+
+void StateTable::rehash_nfa_() {
+  std::vector<size_t> new_slots(nfa_slots_.size() * 2, EMPTY_SLOT);
+  const size_t mask = new_slots.size() - 1;
+  for (size_t k = 0; k < nfa_states_.size(); k++) {
+    size_t i = nfa_states_[k]->hash() & mask;
+    while (new_slots[i] != EMPTY_SLOT)
+      i = (i + 1) & mask;
+    new_slots[i] = k + 1;
+  }
+  nfa_slots_ = std::move(new_slots);
+}
+
+size_t StateTable::intern(const nfa_state_ptr& state) {
+  // keep the load factor below 1/2.
+  if (2 * (nfa_states_.size() + 1) > nfa_slots_.size())
+    rehash_nfa_();
+  size_t i = probe_nfa_(*state);
+  if (nfa_slots_[i] == EMPTY_SLOT) {
+    nfa_states_.push_back(state);
+    nfa_slots_[i] = nfa_states_.size();
+  }
+  return nfa_slots_[i] - 1;
+}
+
+bool StateTable::make_key_(const DFAState& state) const {
+  key_buffer_.clear();
+  for (const auto& nfa_state : state.states) {
+    size_t i = probe_nfa_(*nfa_state);
+    if (nfa_slots_[i] == EMPTY_SLOT)
+      return false;
+    key_buffer_.push_back(nfa_slots_[i] - 1);
+  }
+  std::sort(key_buffer_.begin(), key_buffer_.end());
+  return true;
+}
+
+std::pair<int, bool> StateTable::insert(const DFAState& state, int value) {
+  key_buffer_.clear();
+  for (const auto& nfa_state : state.states)
+    key_buffer_.push_back(intern(nfa_state));
+  std::sort(key_buffer_.begin(), key_buffer_.end());
+  if (2 * (entries_.size() + 1) > slots_.size())
+    rehash_();
+  const hash_t hash = state.hash();
+  size_t i = probe_(hash);
+  if (slots_[i] != EMPTY_SLOT)
+    return {entries_[slots_[i] - 1].value, false};
+  entries_.push_back(Entry{hash, keys_.size(), key_buffer_.size(), value});
+  keys_.insert(keys_.end(), key_buffer_.begin(), key_buffer_.end());
+  slots_[i] = entries_.size();
+  return {value, true};
+}
+
+int StateTable::find(const DFAState& state) const {
+  if (!make_key_(state))
+    return -1;
+  size_t i = probe_(state.hash());
+  if (slots_[i] == EMPTY_SLOT)
+    return -1;
+  return entries_[slots_[i] - 1].value;
+}
+
+} // namespace whitemech::lydia
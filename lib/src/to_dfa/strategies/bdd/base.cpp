@@ -20,6 +20,7 @@
 #include <lydia/logic/nnf.hpp>
 #include <lydia/to_dfa/delta_symbolic.hpp>
 #include <lydia/to_dfa/dfa_state.hpp>
+#include <lydia/to_dfa/state_table.hpp>
 #include <lydia/to_dfa/strategies/bdd/base.hpp>
 #include <lydia/utils/strings.hpp>
 #include <memory>
@@ -30,32 +31,40 @@ namespace whitemech::lydia {
 std::shared_ptr<abstract_dfa> BDDStrategy::to_dfa(const LDLfFormula& formula) {
   auto formula_nnf = to_nnf(formula);
   current_context_ = &formula.ctx();
+  state_table_ = StateTable();
+  expansions_.clear();
   set_formulas initial_state_formulas{formula_nnf};
   dfa_state_ptr initial_state =
       std::make_shared<DFAState>(*current_context_, initial_state_formulas);
 
   // find all atoms
   set_atoms_ptr atoms = find_atoms(*formula_nnf);
+  atom2ids.clear();
+  id2atoms.clear();
   int index = 0;
-  for (const auto& atom : atoms) {
+  for (const auto& atom : atom_ordering->order(*formula_nnf, atoms)) {
     atom2ids[atom] = index;
     id2atoms.push_back(atom);
     index++;
   }
 
-  automaton = std::make_shared<dfa>(mgr, max_nb_bits, atoms.size());
+  automaton = std::make_shared<dfa>(mgr, initial_nb_bits, atoms.size());
+  for (size_t i = 0; i < id2atoms.size(); i++)
+    automaton->variables[i] = id2atoms[i]->str();
   automaton->add_state();
   automaton->set_initial_state(1);
 
   //  Check if the initial state is final
-  if (initial_state->is_final()) {
+  if (is_final_(*initial_state)) {
     automaton->set_final_state(1, true);
   }
 
-  map_dfa_states discovered;
+  StateTable& discovered = state_table_;
+  discovered.insert(*initial_state, 1);
   std::queue<std::pair<dfa_state_ptr, int>> to_be_visited;
   to_be_visited.push(std::make_pair(initial_state, 1));
   while (!to_be_visited.empty()) {
+    check_budget_();
     auto pair = to_be_visited.front();
     to_be_visited.pop();
     const dfa_state_ptr current_state = pair.first;
@@ -68,16 +77,15 @@ std::shared_ptr<abstract_dfa> BDDStrategy::to_dfa(const LDLfFormula& formula) {
       const auto& next_state = symbol_state.first;
       const auto& symbol = symbol_state.second;
       // update states/transitions
-      int next_state_index = 0;
-      if (discovered.find(next_state) == discovered.end()) {
-        next_state_index = automaton->add_state();
-        discovered[next_state] = next_state_index;
+      auto [next_state_index, is_new] =
+          discovered.insert(*next_state, automaton->get_nb_states());
+      if (is_new) {
+        automaton->add_state();
+        check_budget_(automaton->get_nb_states(), mgr.ReadNodeCount());
         to_be_visited.push(std::make_pair(next_state, next_state_index));
-        if (next_state->is_final()) {
+        if (is_final_(*next_state)) {
           automaton->set_final_state(next_state_index, true);
         }
-      } else {
-        next_state_index = discovered[next_state];
       }
 
       add_transition(current_state_index, symbol, next_state_index);
@@ -95,7 +103,7 @@ BDDStrategy::next_transitions(const DFAState& state) {
   set_atoms_ptr symbol;
   std::map<nfa_state_ptr, CUDD::BDD, SharedComparator> all_transitions;
   for (const auto& nfa_state : state.states) {
-    const auto& next_transitions = this->next_transitions(*nfa_state);
+    const auto& next_transitions = get_expansion_(nfa_state, true).transitions;
     for (const auto& pair : next_transitions) {
       if (all_transitions.find(pair.first) == all_transitions.end()) {
         all_transitions[pair.first] = automaton->mgr.bddZero();
@@ -131,16 +139,51 @@ BDDStrategy::next_transitions(const DFAState& state) {
   return result;
 }
 
-std::map<nfa_state_ptr, CUDD::BDD, SharedComparator>
-BDDStrategy::next_transitions(const NFAState& state) {
-  std::map<nfa_state_ptr, CUDD::BDD, SharedComparator> result;
+const NFAStateExpansion&
+BDDStrategy::get_expansion_(const nfa_state_ptr& state, bool expand) {
+  size_t id = state_table_.intern(state);
+  if (id >= expansions_.size())
+    expansions_.resize(id + 1);
+  NFAStateExpansion& expansion = expansions_[id];
+  if (!expansion.initialized) {
+    expansion.is_final = state->is_final();
+    expansion.initialized = true;
+  }
+  if (expand && !expansion.expanded) {
+    expansion.successor_fun = successor_function(*state);
+    expansion.transitions = next_transitions(*state, expansion.successor_fun);
+    expansion.expanded = true;
+  }
+  return expansion;
+}
+
+bool BDDStrategy::is_final_(const DFAState& state) {
+  for (const auto& nfa_state : state.states) {
+    if (get_expansion_(nfa_state, false).is_final)
+      return true;
+  }
+  return false;
+}
+
+CUDD::BDD BDDStrategy::successor_function(const NFAState& state) {
   set_prop_formulas setPropFormulas;
   for (const auto& f : state.formulas) {
     const auto& delta_formula = delta_symbolic(*f, false);
     setPropFormulas.insert(delta_formula);
   }
   auto and_ = current_context_->makePropAnd(setPropFormulas);
-  CUDD::BDD successor_fun = bdd_delta_symbolic(*this, *and_);
+  return bdd_delta_symbolic(*this, *and_);
+}
+
+std::map<nfa_state_ptr, CUDD::BDD, SharedComparator>
+BDDStrategy::next_transitions(const NFAState& state) {
+  return next_transitions(state, successor_function(state));
+}
+
+std::map<nfa_state_ptr, CUDD::BDD, SharedComparator>
+BDDStrategy::next_transitions(const NFAState& state,
+                              const CUDD::BDD& successor_fun) {
+  std::map<nfa_state_ptr, CUDD::BDD, SharedComparator> result;
   if (successor_fun.IsZero())
     return result;
 
@@ -148,27 +191,28 @@ BDDStrategy::next_transitions(const NFAState& state) {
   int* cube = nullptr;
   DdGen* g = Cudd_FirstPrime(mgr.getManager(), successor_fun.getNode(),
                              successor_fun.getNode(), &cube);
-  size_t nb_all_variables =
-      automaton->nb_bits + automaton->get_nb_variables() + id2subformula.size();
-  size_t nb_automaton_variables =
-      automaton->nb_bits + automaton->get_nb_variables();
+  // the automaton may add state bits while the translation is running,
+  // so we look up the cube by CUDD variable index rather than by position.
+  size_t nb_bits = automaton->nb_bits;
+  size_t nb_variables = automaton->get_nb_variables();
   if (g != nullptr) {
     do {
       CUDD::BDD symbol = mgr.bddOne();
       set_formulas next_state;
-      for (size_t i = automaton->nb_bits; i < nb_automaton_variables; i++) {
-        if (cube[i] == 2)
+      for (size_t i = 0; i < nb_variables; i++) {
+        CUDD::BDD tmp = automaton->bddvars[nb_bits + i];
+        int value = cube[tmp.NodeReadIndex()];
+        if (value == 2)
           continue;
-        CUDD::BDD tmp = automaton->bddvars[i];
-        if (cube[i] == 0) {
+        if (value == 0) {
           tmp = !tmp;
         }
         symbol &= tmp;
       }
 
-      for (size_t i = nb_automaton_variables; i < nb_all_variables; i++) {
-        if (cube[i] == 1) {
-          next_state.insert(id2subformula[i - nb_automaton_variables]);
+      for (size_t i = 0; i < subformula_bddvars.size(); i++) {
+        if (cube[subformula_bddvars[i].NodeReadIndex()] == 1) {
+          next_state.insert(id2subformula[i]);
         }
       }
 
@@ -185,15 +229,7 @@ BDDStrategy::next_transitions(const NFAState& state) {
 
 void BDDStrategy::add_transition(int from_index, CUDD::BDD guard,
                                  int to_index) {
-  std::string to_binary = state2bin(to_index, automaton->nb_bits, true);
-  //  Update each root BDD.
-  guard = guard * automaton->state2bdd(from_index);
-  assert(automaton->nb_bits == to_binary.length());
-  for (int i = 0; i < automaton->nb_bits; i++) {
-    bool result = int(to_binary[i]) - '0';
-    if (result)
-      automaton->root_bdds[i] += guard;
-  }
+  automaton->add_transition(from_index, guard, to_index);
 }
 
 } // namespace whitemech::lydia
\ No newline at end of file
@@ -15,6 +15,7 @@
  * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <lydia/logic/ldlf/test_free.hpp>
 #include <lydia/to_dfa/strategies/compositional/base.hpp>
 #include <lydia/to_dfa/strategies/compositional/star.hpp>
@@ -27,6 +28,17 @@ DFA* ComposeDFAVisitor::apply(const LDLfFormula& f) {
   f.accept(*this);
   return result;
 }
+DFA* ComposeDFAVisitor::apply_operand(const LDLfFormula& f) {
+  if (!cs.use_templates)
+    return apply(f);
+  auto t = make_template(f, cs.atom2ids);
+  DFA* automaton = cs.templates.instantiate(t);
+  if (automaton != nullptr)
+    return automaton;
+  automaton = apply(f);
+  cs.templates.insert(t, automaton);
+  return automaton;
+}
 DFA* ComposeDFARegexVisitor::apply(const RegExp& f) {
   result = nullptr;
   f.accept(*this);
@@ -43,12 +55,12 @@ CompositionalStrategy::to_dfa(const LDLfFormula& formula) {
   reset();
   auto formula_nnf = to_nnf(formula);
   auto atoms_set = find_atoms(*formula_nnf);
+  auto result = to_dfa_internal(*formula_nnf, atoms_set);
   auto names = std::vector<std::string>();
-  names.reserve(atoms_set.size());
-  for (const auto& atom : atoms_set) {
+  names.reserve(id2atoms.size());
+  for (const auto& atom : id2atoms) {
     names.push_back(atom->str());
   }
-  auto result = to_dfa_internal(*formula_nnf, atoms_set);
   return std::make_shared<mona_dfa>(result, names);
 }
 
@@ -56,7 +68,7 @@ DFA* CompositionalStrategy::to_dfa_internal(const LDLfFormula& f,
                                             set_atoms_ptr atoms_set) {
   int index = 0;
   atoms = std::move(atoms_set);
-  for (const auto& atom : atoms) {
+  for (const auto& atom : atom_ordering->order(f, atoms)) {
     atom2ids[atom] = index;
     id2atoms.push_back(atom);
     index++;
@@ -65,7 +77,66 @@ DFA* CompositionalStrategy::to_dfa_internal(const LDLfFormula& f,
   std::iota(indices.begin(), indices.end(), 0);
   auto visitor = ComposeDFAVisitor(*this);
   auto result = visitor.apply(f);
-  return result;
+  return minimization.finalize(result);
+}
+
+void CompositionalStrategy::check_budget(DFA* automaton) {
+  try {
+    check_budget_(automaton->ns, bdd_size(automaton->bddm));
+  } catch (...) {
+    dfaFree(automaton);
+    throw;
+  }
+}
+
+void CompositionalStrategy::combine_small_operands(std::vector<DFA*>& dfas,
+                                                   dfaProductType type,
+                                                   bool is_positive) {
+  if (!use_nary_product || nary_product_max_arity < 3 || dfas.size() < 3)
+    return;
+  auto small = std::vector<DFA*>();
+  auto others = std::vector<DFA*>();
+  for (auto automaton : dfas) {
+    if ((size_t)automaton->ns <= nary_product_max_states)
+      small.push_back(automaton);
+    else
+      others.push_back(automaton);
+  }
+  if (small.size() < 3)
+    return;
+
+  // smallest first, so that the chunks have similar sizes.
+  auto cmp = [](const DFA* d1, const DFA* d2) { return d1->ns < d2->ns; };
+  std::stable_sort(small.begin(), small.end(), cmp);
+  dfas = others;
+  for (size_t begin = 0; begin < small.size();
+       begin += nary_product_max_arity) {
+    size_t end = std::min(begin + nary_product_max_arity, small.size());
+    auto chunk = std::vector<DFA*>(small.begin() + begin, small.begin() + end);
+    DFA* product =
+        minimize(dfa_nary_product(chunk, type), chunk.back()->ns);
+    for (auto automaton : chunk)
+      dfaFree(automaton);
+    try {
+      check_budget(product);
+    } catch (...) {
+      for (size_t i = end; i < small.size(); i++)
+        dfaFree(small[i]);
+      for (auto automaton : dfas)
+        dfaFree(automaton);
+      dfas.clear();
+      throw;
+    }
+    if (is_sink(product, is_positive)) {
+      for (size_t i = end; i < small.size(); i++)
+        dfaFree(small[i]);
+      for (auto automaton : dfas)
+        dfaFree(automaton);
+      dfas = {product};
+      return;
+    }
+    dfas.push_back(product);
+  }
 }
 
 void CompositionalStrategy::reset() {
@@ -73,6 +144,7 @@ void CompositionalStrategy::reset() {
   id2atoms = std::vector<atom_ptr>{};
   atom2ids = std::map<atom_ptr, size_t, SharedComparator>{};
   indices = std::vector<int>{};
+  templates.clear();
 }
 
 void ComposeDFAVisitor::visit(const LDLfTrue& f) { result = dfaLDLfTrue(); }
@@ -90,9 +162,10 @@ void ComposeDFAVisitor::visit(const LDLfOr& f) {
 
 void ComposeDFAVisitor::visit(const LDLfNot& f) {
   DFA* tmp = apply(*f.get_arg());
+  const size_t operand_nb_states = tmp->ns;
   dfaNegation(tmp);
-  result = dfaMinimize(tmp);
-  dfaFree(tmp);
+  result = cs.minimize(tmp, operand_nb_states);
+  cs.check_budget(result);
 }
 
 void ComposeDFAVisitor::visit(const LDLfDiamond& f) {
@@ -129,12 +202,17 @@ void ComposeDFARegexVisitor::visit(const UnionRegExp& r) {
   auto op = is_diamond ? dfaOR : dfaAND;
   for (const auto& x : r.get_container()) {
     tmp1 = final;
-    tmp2 = apply(*x);
+    try {
+      tmp2 = apply(*x);
+    } catch (...) {
+      dfaFree(tmp1);
+      throw;
+    }
     tmp3 = dfaProduct(tmp1, tmp2, op);
-    final = dfaMinimize(tmp3);
+    final = cs.minimize(tmp3, std::max(tmp1->ns, tmp2->ns));
     dfaFree(tmp1);
     dfaFree(tmp2);
-    dfaFree(tmp3);
+    cs.check_budget(final);
     if (is_sink(final, is_diamond))
       break;
   }
@@ -146,14 +224,28 @@ void ComposeDFARegexVisitor::visit(const SequenceRegExp& r) {
   auto subregexes = r.get_container();
   DFA* final = nullptr;
   DFA* tmp;
+  size_t final_nb_states = current_formula_->ns;
 
   for (auto it = subregexes.rbegin(); it != subregexes.rend(); it++) {
-    tmp = apply(**it);
+    try {
+      tmp = apply(**it);
+    } catch (...) {
+      if (final)
+        dfaFree(final);
+      current_formula_ = old_formula;
+      throw;
+    }
     if (final)
       dfaFree(final);
-    final = dfaMinimize(tmp);
+    final = cs.minimize(tmp, final_nb_states);
+    final_nb_states = final->ns;
     current_formula_ = final;
-    dfaFree(tmp);
+    try {
+      cs.check_budget(final);
+    } catch (...) {
+      current_formula_ = old_formula;
+      throw;
+    }
   }
   result = current_formula_;
   current_formula_ = old_formula;
@@ -169,11 +261,11 @@ void ComposeDFARegexVisitor::visit(const StarRegExp& r) {
 
 void ComposeDFARegexVisitor::test_free_star_(const StarRegExp& r) {
   DFA* tmp;
-  DFA* body = dfaCopy(current_formula_);
-
+  // the body is copied after the argument, whose translation may throw.
   auto visitor = ComposeDFAVisitor(cs);
   DFA* regex = visitor.apply(
       *r.ctx().makeLdlfDiamond(r.get_arg(), r.ctx().makeLdlfEnd()));
+  DFA* body = dfaCopy(current_formula_);
 
   DFA* regex_or_empty = dfa_accept_empty(regex);
   DFA* star = dfa_closure(regex_or_empty, cs.indices.size(), cs.indices.data());
@@ -184,12 +276,13 @@ void ComposeDFARegexVisitor::test_free_star_(const StarRegExp& r) {
   if (not is_diamond) {
     dfaNegation(tmp);
   }
-  result = dfaMinimize(tmp);
-  dfaFree(tmp);
+  DFA* automaton = cs.minimize(tmp, std::max(star->ns, body->ns));
   dfaFree(regex);
   dfaFree(regex_or_empty);
   dfaFree(star);
   dfaFree(body);
+  cs.check_budget(automaton);
+  result = automaton;
 }
 
 void ComposeDFARegexVisitor::general_star_(const StarRegExp& r) {
@@ -197,13 +290,20 @@ void ComposeDFARegexVisitor::general_star_(const StarRegExp& r) {
   if (not is_diamond) {
     dfaNegation(body);
   }
-  DFA* tmp = cs.star(r, body);
+  DFA* tmp;
+  try {
+    tmp = cs.star(r, body);
+  } catch (...) {
+    dfaFree(body);
+    throw;
+  }
   if (not is_diamond) {
     dfaNegation(tmp);
   }
-  result = dfaMinimize(tmp);
-  dfaFree(tmp);
+  DFA* automaton = cs.minimize(tmp, body->ns);
   dfaFree(body);
+  cs.check_budget(automaton);
+  result = automaton;
 }
 
 void ComposeDFARegexVisitor::visit(const TestRegExp& r) {
@@ -212,9 +312,11 @@ void ComposeDFARegexVisitor::visit(const TestRegExp& r) {
   auto visitor = ComposeDFAVisitor(cs);
   DFA* regex_dfa = visitor.apply(*r.get_arg());
   tmp = dfaProduct(regex_dfa, current_formula_, op);
-  result = dfaMinimize(tmp);
+  DFA* automaton =
+      cs.minimize(tmp, std::max(regex_dfa->ns, current_formula_->ns));
   dfaFree(regex_dfa);
-  dfaFree(tmp);
+  cs.check_budget(automaton);
+  result = automaton;
 }
 
 void ComposeDFARegexVisitor::visit(const PropositionalRegExp& r) {
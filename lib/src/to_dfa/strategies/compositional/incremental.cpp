@@ -0,0 +1,102 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <lydia/logic/atom_visitor.hpp>
+#include <lydia/logic/nnf.hpp>
+#include <lydia/to_dfa/strategies/compositional/incremental.hpp>
+#include <numeric>
+
+namespace whitemech::lydia {
+
+IncrementalTranslator::IncrementalTranslator(CompositionalStrategy& strategy,
+                                             bool initial_value)
+    : strategy_{strategy},
+      current_{initial_value ? dfaLDLfTrue() : dfaLDLfFalse()} {}
+
+IncrementalTranslator::~IncrementalTranslator() { dfaFree(current_); }
+
+void IncrementalTranslator::reset(bool initial_value) {
+  dfaFree(current_);
+  current_ = initial_value ? dfaLDLfTrue() : dfaLDLfFalse();
+  atoms_.clear();
+  id2atoms_.clear();
+}
+
+void IncrementalTranslator::add_atoms_(const set_atoms_ptr& atoms) {
+  size_t old_size = atoms_.size();
+  atoms_.insert(atoms.begin(), atoms.end());
+  if (atoms_.size() == old_size)
+    return;
+
+  // the atoms are sorted: the old atoms keep their relative order.
+  auto new_id2atoms = std::vector<atom_ptr>(atoms_.begin(), atoms_.end());
+  auto indices_map = std::vector<int>(old_size);
+  bool is_identity = true;
+  for (size_t new_id = 0, old_id = 0; old_id < old_size; new_id++) {
+    if (new_id2atoms[new_id] != id2atoms_[old_id])
+      continue;
+    indices_map[old_id] = new_id;
+    is_identity = is_identity && old_id == new_id;
+    old_id++;
+  }
+  if (!is_identity)
+    dfaReplaceIndices(current_, indices_map.data());
+  id2atoms_ = std::move(new_id2atoms);
+
+  strategy_.atoms = atoms_;
+  strategy_.id2atoms = id2atoms_;
+  strategy_.atom2ids.clear();
+  for (size_t i = 0; i < id2atoms_.size(); i++)
+    strategy_.atom2ids[id2atoms_[i]] = i;
+  strategy_.indices = std::vector<int>(id2atoms_.size());
+  std::iota(strategy_.indices.begin(), strategy_.indices.end(), 0);
+}
+
+void IncrementalTranslator::combine_(const LDLfFormula& formula,
+                                     dfaProductType type, bool is_positive) {
+  auto formula_nnf = to_nnf(formula);
+  add_atoms_(find_atoms(*formula_nnf));
+  // the current DFA is a dominant sink: nothing to do.
+  if (is_sink(current_, is_positive))
+    return;
+
+  auto visitor = ComposeDFAVisitor(strategy_);
+  DFA* operand = strategy_.minimization.finalize(visitor.apply(*formula_nnf));
+  DFA* product = dfaProduct(current_, operand, type);
+  DFA* result = dfaMinimize(product);
+  dfaFree(product);
+  dfaFree(operand);
+  dfaFree(current_);
+  current_ = result;
+}
+
+void IncrementalTranslator::conjoin(const LDLfFormula& formula) {
+  combine_(formula, dfaAND, false);
+}
+
+void IncrementalTranslator::disjoin(const LDLfFormula& formula) {
+  combine_(formula, dfaOR, true);
+}
+
+std::shared_ptr<mona_dfa> IncrementalTranslator::get_dfa() const {
+  auto names = std::vector<std::string>();
+  names.reserve(id2atoms_.size());
+  for (const auto& atom : id2atoms_)
+    names.push_back(atom->str());
+  return std::make_shared<mona_dfa>(dfaCopy(current_), names);
+}
+
+} // namespace whitemech::lydia
@@ -0,0 +1,74 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <lydia/to_dfa/strategies/compositional/minimization.hpp>
+
+namespace whitemech::lydia {
+
+std::chrono::microseconds
+MinimizationStatistics::estimated_time_saved() const {
+  if (states_before == 0)
+    return std::chrono::microseconds{0};
+  double per_state = (double)time_spent.count() / (double)states_before;
+  return std::chrono::microseconds{(long long)(per_state * states_skipped)};
+}
+
+bool MinimizationPolicy::is_required_(const DFA* automaton,
+                                      size_t operand_nb_states) const {
+  switch (mode) {
+  case MinimizationMode::always:
+    return true;
+  case MinimizationMode::size_threshold:
+    return (size_t)automaton->ns > size_threshold;
+  case MinimizationMode::ratio:
+    return automaton->ns > ratio * (double)operand_nb_states;
+  case MinimizationMode::final_only:
+    return false;
+  }
+  return true;
+}
+
+DFA* MinimizationPolicy::do_minimize_(DFA* automaton) {
+  auto start = std::chrono::steady_clock::now();
+  DFA* result = dfaMinimize(automaton);
+  statistics_.time_spent +=
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+  ++statistics_.nb_minimizations;
+  statistics_.states_before += automaton->ns;
+  statistics_.states_pruned += automaton->ns - result->ns;
+  dfaFree(automaton);
+  return result;
+}
+
+DFA* MinimizationPolicy::minimize(DFA* automaton, size_t operand_nb_states) {
+  ++statistics_.nb_requests;
+  if (is_required_(automaton, operand_nb_states))
+    return do_minimize_(automaton);
+  ++statistics_.nb_skipped;
+  statistics_.states_skipped += automaton->ns;
+  return automaton;
+}
+
+DFA* MinimizationPolicy::finalize(DFA* automaton) {
+  // with the default mode, the result is already minimal.
+  if (mode == MinimizationMode::always)
+    return automaton;
+  ++statistics_.nb_requests;
+  return do_minimize_(automaton);
+}
+
+} // namespace whitemech::lydia
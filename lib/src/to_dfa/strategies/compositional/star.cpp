@@ -77,6 +77,7 @@ DFA* CompositionalStrategy::star(const RegExp& r, DFA* body) {
 
   to_be_visited.push(std::make_pair(formula, 0));
   while (!to_be_visited.empty()) {
+    check_budget_(discovered.size(), 0);
     auto pair = to_be_visited.front();
     auto current_state = pair.first;
     auto state_id = pair.second;
@@ -146,12 +147,18 @@ DFA* CompositionalStrategy::star(const RegExp& r, DFA* body) {
     transitions_by_state[state_id] = existential_transitions;
   }
 
-  test_formula_to_dfa.resize(test2id.size());
+  test_formula_to_dfa.resize(test2id.size(), nullptr);
   for (const auto& pair : test2id) {
     const auto& test_expr = pair.first;
     auto compose_visitor = ComposeDFAVisitor(*this);
-    DFA* tmp = compose_visitor.apply(*test_expr);
-    test_formula_to_dfa[pair.second] = tmp;
+    try {
+      test_formula_to_dfa[pair.second] = compose_visitor.apply(*test_expr);
+    } catch (...) {
+      for (DFA* test_dfa : test_formula_to_dfa)
+        if (test_dfa)
+          dfaFree(test_dfa);
+      throw;
+    }
   }
 
   // ----------------------------------------------------------------
@@ -0,0 +1,97 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <lydia/logic/atom_visitor.hpp>
+#include <lydia/to_dfa/strategies/compositional/templates.hpp>
+#include <lydia/utils/print.hpp>
+
+namespace whitemech::lydia {
+
+/*
+ * Print a formula, replacing every atom with its placeholder.
+ */
+class TemplatePrinter : public StrPrinter {
+private:
+  const std::map<std::string, int>& ranks_;
+
+public:
+  using StrPrinter::visit;
+
+  explicit TemplatePrinter(const std::map<std::string, int>& ranks)
+      : ranks_{ranks} {}
+
+  void visit(const PropositionalAtom& x) override {
+    result = "#" + std::to_string(ranks_.at(x.str()));
+  }
+};
+
+FormulaTemplate
+make_template(const LDLfFormula& formula,
+              const std::map<atom_ptr, size_t, SharedComparator>& atom2ids) {
+  auto atoms = find_atoms(formula);
+  std::vector<std::pair<int, std::string>> id2name;
+  id2name.reserve(atoms.size());
+  for (const auto& atom : atoms)
+    id2name.emplace_back(atom2ids.at(atom), atom->str());
+  std::sort(id2name.begin(), id2name.end());
+
+  FormulaTemplate result;
+  std::map<std::string, int> ranks;
+  for (const auto& [id, name] : id2name) {
+    ranks[name] = result.atom_ids.size();
+    result.atom_ids.push_back(id);
+  }
+  result.key = TemplatePrinter(ranks).apply(formula);
+  return result;
+}
+
+DFA* TemplateCache::instantiate(const FormulaTemplate& t) {
+  auto it = templates_.find(t.key);
+  if (it == templates_.end()) {
+    ++statistics_.nb_misses;
+    return nullptr;
+  }
+  ++statistics_.nb_hits;
+  DFA* result = dfaCopy(it->second);
+  if (!t.atom_ids.empty()) {
+    auto indices_map = t.atom_ids;
+    dfaReplaceIndices(result, indices_map.data());
+  }
+  return result;
+}
+
+void TemplateCache::insert(const FormulaTemplate& t, DFA* automaton) {
+  if (templates_.find(t.key) != templates_.end())
+    return;
+  DFA* result = dfaCopy(automaton);
+  if (!t.atom_ids.empty()) {
+    // the identifiers are sorted, so the map is monotone.
+    auto indices_map = std::vector<int>(t.atom_ids.back() + 1, 0);
+    for (size_t i = 0; i < t.atom_ids.size(); i++)
+      indices_map[t.atom_ids[i]] = i;
+    dfaReplaceIndices(result, indices_map.data());
+  }
+  templates_.emplace(t.key, result);
+}
+
+void TemplateCache::clear() {
+  for (const auto& [key, automaton] : templates_)
+    dfaFree(automaton);
+  templates_.clear();
+}
+
+} // namespace whitemech::lydia
@@ -17,6 +17,7 @@
 
 #include <lydia/logic/pl/models/base.hpp>
 #include <lydia/logic/pl/models/naive.hpp>
+#include <lydia/to_dfa/state_table.hpp>
 #include <lydia/to_dfa/strategies/naive.hpp>
 
 namespace whitemech::lydia {
@@ -33,14 +34,19 @@ NaiveStrategy::to_dfa(const LDLfFormula& formula) {
   // find all atoms
   set_atoms_ptr atoms = find_atoms(*formula_nnf);
   map_atoms_ptr atom2index;
+  std::vector<atom_ptr> id2atoms(atoms.begin(), atoms.end());
   int index = 0;
   for (const auto& atom : atoms)
     atom2index[atom] = index++;
-  auto all_interpretations = powerset<atom_ptr, SharedComparator>(atoms);
+  std::vector<set_atoms_ptr> all_interpretations;
+  if (!gray_code_sweep)
+    all_interpretations = powerset<atom_ptr, SharedComparator>(atoms);
 
   // TODO max number of bits
   std::shared_ptr<dfa> automaton =
-      std::make_shared<dfa>(mgr, max_nb_bits, atoms.size());
+      std::make_shared<dfa>(mgr, initial_nb_bits, atoms.size());
+  for (size_t i = 0; i < id2atoms.size(); i++)
+    automaton->variables[i] = id2atoms[i]->str();
   automaton->add_state();
   automaton->set_initial_state(1);
 
@@ -50,14 +56,35 @@ NaiveStrategy::to_dfa(const LDLfFormula& formula) {
   }
 
   // BFS exploration of the automaton.
-  map_dfa_states discovered;
+  StateTable discovered;
+  discovered.insert(*initial_state, 1);
   std::queue<std::pair<dfa_state_ptr, int>> to_be_visited;
   to_be_visited.push(std::make_pair(initial_state, 1));
   while (!to_be_visited.empty()) {
+    check_budget_();
     auto pair = to_be_visited.front();
     to_be_visited.pop();
     const dfa_state_ptr current_state = pair.first;
     auto current_state_index = pair.second;
+    if (gray_code_sweep) {
+      const auto& transitions =
+          NaiveStrategy::next_transitions(*current_state, id2atoms, *automaton);
+      for (const auto& [next_state, guard] : transitions) {
+        auto [next_state_index, is_new] =
+            discovered.insert(*next_state, automaton->get_nb_states());
+        if (is_new) {
+          automaton->add_state();
+          check_budget_(automaton->get_nb_states(), mgr.ReadNodeCount());
+          to_be_visited.push(std::make_pair(next_state, next_state_index));
+          if (next_state->is_final()) {
+            automaton->set_final_state(next_state_index, true);
+          }
+        }
+        automaton->add_transition(current_state_index, guard,
+                                  next_state_index);
+      }
+      continue;
+    }
     /*
      * TODO: naive implementation: do a loop for every interpretation
      *       improvement: delta function returns a list of possible successors
@@ -67,16 +94,15 @@ NaiveStrategy::to_dfa(const LDLfFormula& formula) {
       const dfa_state_ptr next_state =
           NaiveStrategy::next_state(*current_state, i);
       // update states/transitions
-      int next_state_index = 0;
-      if (discovered.find(next_state) == discovered.end()) {
-        next_state_index = automaton->add_state();
-        discovered[next_state] = next_state_index;
+      auto [next_state_index, is_new] =
+          discovered.insert(*next_state, automaton->get_nb_states());
+      if (is_new) {
+        automaton->add_state();
+        check_budget_(automaton->get_nb_states(), mgr.ReadNodeCount());
         to_be_visited.push(std::make_pair(next_state, next_state_index));
         if (next_state->is_final()) {
           automaton->set_final_state(next_state_index, true);
         }
-      } else {
-        next_state_index = discovered[next_state];
       }
 
       interpretation_set x{};
@@ -126,4 +152,74 @@ set_nfa_states NaiveStrategy::next_states(const NFAState& state,
   return result;
 }
 
+std::vector<std::pair<dfa_state_ptr, CUDD::BDD>>
+NaiveStrategy::next_transitions(const DFAState& state,
+                                const std::vector<atom_ptr>& atoms,
+                                const dfa& automaton) {
+  const size_t nb_atoms = atoms.size();
+  assert(nb_atoms < 8 * sizeof(size_t));
+  const std::vector<nfa_state_ptr> nfa_states(state.states.begin(),
+                                              state.states.end());
+
+  // relevant[k][j] iff the atom j occurs in the NFA state k.
+  std::vector<std::vector<bool>> relevant(nfa_states.size(),
+                                          std::vector<bool>(nb_atoms, false));
+  for (size_t k = 0; k < nfa_states.size(); k++) {
+    for (const auto& formula : nfa_states[k]->formulas) {
+      for (const auto& atom : find_atoms(*formula)) {
+        auto it = std::lower_bound(atoms.begin(), atoms.end(), atom,
+                                   SharedComparator());
+        if (it != atoms.end() && **it == *atom)
+          relevant[k][it - atoms.begin()] = true;
+      }
+    }
+  }
+
+  // start from the empty interpretation.
+  std::vector<bool> values(nb_atoms, false);
+  set_atoms_ptr current;
+  std::vector<set_nfa_states> successors(nfa_states.size());
+  for (size_t k = 0; k < nfa_states.size(); k++)
+    successors[k] = next_states(*nfa_states[k], current);
+
+  std::vector<std::pair<dfa_state_ptr, CUDD::BDD>> result;
+  StateTable grouped;
+  const size_t nb_interpretations = size_t(1) << nb_atoms;
+  for (size_t g = 0; g < nb_interpretations; g++) {
+    if (g > 0) {
+      // going from the Gray code of g-1 to the one of g flips
+      // the lowest set bit of g.
+      size_t j = 0;
+      while (((g >> j) & 1) == 0)
+        ++j;
+      values[j] = !values[j];
+      if (values[j])
+        current.insert(atoms[j]);
+      else
+        current.erase(atoms[j]);
+      for (size_t k = 0; k < nfa_states.size(); k++) {
+        if (relevant[k][j])
+          successors[k] = next_states(*nfa_states[k], current);
+      }
+    }
+
+    set_nfa_states next_nfa_states;
+    for (const auto& s : successors)
+      next_nfa_states.insert(s.begin(), s.end());
+    auto next_state =
+        std::make_shared<DFAState>(state.context, next_nfa_states);
+
+    CUDD::BDD minterm = automaton.mgr.bddOne();
+    for (size_t j = 0; j < nb_atoms; j++)
+      minterm *= automaton.prop2bddvar(j, values[j]);
+
+    auto [position, is_new] = grouped.insert(*next_state, result.size());
+    if (is_new)
+      result.emplace_back(next_state, minterm);
+    else
+      result[position].second += minterm;
+  }
+  return result;
+}
+
 } // namespace whitemech::lydia
\ No newline at end of file
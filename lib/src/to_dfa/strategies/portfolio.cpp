@@ -0,0 +1,248 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <lydia/dfa/mona_file.hpp>
+#include <lydia/mona_ext/mona_ext_base.hpp>
+#include <lydia/to_dfa/strategies/portfolio.hpp>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace whitemech::lydia {
+
+Logger PortfolioStrategy::logger = Logger("portfolio");
+
+PortfolioStrategy::PortfolioStrategy(
+    std::vector<std::pair<std::string, std::shared_ptr<Strategy>>> strategies)
+    : strategies_{std::move(strategies)} {
+  if (strategies_.empty())
+    throw std::invalid_argument("The portfolio must contain a strategy.");
+}
+
+std::string PortfolioStrategy::signature() const {
+  std::string result = "portfolio(";
+  for (const auto& [name, strategy] : strategies_) {
+    auto s = strategy->signature();
+    if (s.empty())
+      return "";
+    result += s + ";";
+  }
+  return result + ")";
+}
+
+// exit status of a child process that exceeded the budget.
+static const int EXIT_BUDGET_EXCEEDED = 2;
+
+/*
+ * Create an empty temporary file with a unique name, for the result of
+ * a child process. The name is unique also across concurrent or nested
+ * portfolios, in this process or in other ones.
+ *
+ * Return the empty string if the file cannot be created.
+ */
+static std::string make_temp_file() {
+  auto path = (std::filesystem::temp_directory_path() /
+               "lydia-portfolio-XXXXXX.dfa")
+                  .string();
+  int fd = mkstemps(path.data(), 4);
+  if (fd == -1)
+    return "";
+  close(fd);
+  return path;
+}
+
+static void remove_files(const std::vector<std::string>& filenames) {
+  for (const auto& filename : filenames) {
+    std::error_code ec;
+    std::filesystem::remove(filename, ec);
+  }
+}
+
+/*
+ * Read the budget violation written by a child process, if any.
+ */
+static std::unique_ptr<budget_exceeded_error>
+read_budget_error(const std::string& filename) {
+  std::ifstream f(filename);
+  int violation;
+  TranslationStatistics statistics;
+  long elapsed;
+  if (!(f >> violation >> statistics.nb_checks >>
+        statistics.nb_intermediate_dfas >> statistics.max_dfa_states >>
+        statistics.max_bdd_nodes >> elapsed))
+    return nullptr;
+  statistics.elapsed = std::chrono::milliseconds(elapsed);
+  return std::make_unique<budget_exceeded_error>(BudgetViolation(violation),
+                                                 statistics);
+}
+
+/*
+ * The names of the variables of a DFA, in the order of its variable ids.
+ */
+static std::vector<std::string> variable_names(const abstract_dfa& automaton) {
+  if (auto m = dynamic_cast<const mona_dfa*>(&automaton))
+    return m->names;
+  auto d = dynamic_cast<const dfa*>(&automaton);
+  if (d && int(d->variables.size()) == d->get_nb_variables())
+    return d->variables;
+  throw std::runtime_error("The names of the variables are unknown.");
+}
+
+/*
+ * Run the strategy and export the result. Executed in the child process.
+ *
+ * If the budget is exceeded, the violation and the statistics
+ * are written in the file instead.
+ */
+static int run_strategy(Strategy& strategy, const LDLfFormula& formula,
+                        const std::string& filename) {
+  try {
+    auto result = strategy.to_dfa(formula);
+    auto mona_result = std::dynamic_pointer_cast<mona_dfa>(result);
+    if (!mona_result) {
+      mona_result = std::make_shared<mona_dfa>(dfa_from_abstract_dfa(*result),
+                                               variable_names(*result));
+    }
+    mona_result->export_dfa(filename);
+    return EXIT_SUCCESS;
+  } catch (const budget_exceeded_error& e) {
+    std::ofstream f(filename);
+    f << int(e.violation) << " " << e.statistics.nb_checks << " "
+      << e.statistics.nb_intermediate_dfas << " "
+      << e.statistics.max_dfa_states << " " << e.statistics.max_bdd_nodes
+      << " " << e.statistics.elapsed.count();
+    return EXIT_BUDGET_EXCEEDED;
+  } catch (...) {
+    return EXIT_FAILURE;
+  }
+}
+
+std::shared_ptr<abstract_dfa>
+PortfolioStrategy::to_dfa(const LDLfFormula& formula) {
+  winner_.clear();
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::string> filenames;
+  std::vector<pid_t> pids;
+  for (size_t i = 0; i < strategies_.size(); i++) {
+    filenames.push_back(make_temp_file());
+    pid_t pid = filenames.back().empty() ? -1 : fork();
+    if (pid == 0) {
+      strategies_[i].second->set_budget(budget_);
+      std::_Exit(
+          run_strategy(*strategies_[i].second, formula, filenames.back()));
+    }
+    if (pid == -1) {
+      for (pid_t running : pids) {
+        kill(running, SIGKILL);
+        waitpid(running, nullptr, 0);
+      }
+      remove_files(filenames);
+      throw std::runtime_error("Cannot start the strategy " +
+                               strategies_[i].first);
+    }
+    pids.push_back(pid);
+  }
+
+  // poll the children, until one of them succeeds or all of them fail.
+  int winner = -1;
+  std::unique_ptr<budget_exceeded_error> budget_error;
+  size_t nb_running = pids.size();
+  while (winner == -1 && nb_running > 0) {
+    try {
+      check_budget_();
+    } catch (...) {
+      for (pid_t pid : pids) {
+        if (pid == -1)
+          continue;
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+      }
+      remove_files(filenames);
+      throw;
+    }
+    for (size_t i = 0; i < pids.size() && winner == -1; i++) {
+      if (pids[i] == -1)
+        continue;
+      int status;
+      if (waitpid(pids[i], &status, WNOHANG) != pids[i])
+        continue;
+      pids[i] = -1;
+      --nb_running;
+      if (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS) {
+        winner = i;
+      } else if (WIFEXITED(status) &&
+                 WEXITSTATUS(status) == EXIT_BUDGET_EXCEEDED) {
+        logger.debug("strategy {} exceeded the budget", strategies_[i].first);
+        budget_error = read_budget_error(filenames[i]);
+      } else {
+        logger.debug("strategy {} failed", strategies_[i].first);
+      }
+    }
+    if (winner == -1 && nb_running > 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // cancel the other strategies.
+  for (pid_t pid : pids) {
+    if (pid == -1)
+      continue;
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+  }
+
+  // the winner numbered the variables by its own atom ordering: read the
+  // names back from the exported file.
+  DFA* result = nullptr;
+  std::vector<std::string> names;
+  if (winner != -1) {
+    char** vars;
+    int* orders;
+    try {
+      names = parse_mona_dfa_file(filenames[winner]).variables;
+      result = dfaImport(filenames[winner].data(), &vars, &orders);
+    } catch (const std::runtime_error& e) {
+      logger.error("cannot read the result of strategy {}: {}",
+                   strategies_[winner].first, e.what());
+    }
+    if (result != nullptr) {
+      for (size_t i = 0; i < names.size(); i++)
+        mem_free(vars[i]);
+      mem_free(vars);
+      mem_free(orders);
+    }
+  }
+  remove_files(filenames);
+  // if all the strategies failed, and (at least) one of them because of the
+  // budget, report the last budget violation.
+  if (result == nullptr && budget_error)
+    throw *budget_error;
+  if (result == nullptr)
+    throw std::runtime_error("All the strategies of the portfolio failed.");
+
+  winner_ = strategies_[winner].first;
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  logger.info("strategy {} won in {} ms", winner_, elapsed.count());
+  return std::make_shared<mona_dfa>(result, names);
+}
+
+} // namespace whitemech::lydia
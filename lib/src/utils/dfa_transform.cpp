@@ -110,10 +110,12 @@ void dumpdot(const CUDD::Cudd& mgr, const CUDD::BDD& b,
 void bdd2dot(const dfa& automaton, const std::vector<std::string>& names,
              const std::string& directory) {
   const auto size = automaton.root_bdds.size();
-  std::vector<const char*> inames;
-  inames.reserve(names.size());
-  std::transform(names.begin(), names.end(), std::back_inserter(inames),
-                 [](const std::string& s) { return s.c_str(); });
+  // CUDD expects the names indexed by variable index, which might differ
+  // from the position in bddvars if bits have been added.
+  std::vector<const char*> inames(automaton.mgr.ReadSize(), nullptr);
+  for (int i = 0; i < names.size(); i++) {
+    inames[automaton.bddvars[i].NodeReadIndex()] = names[i].c_str();
+  }
   for (int i = 0; i < size; i++) {
     std::string filename = directory + "/" + std::to_string(i);
     dumpdot(automaton.mgr, automaton.root_bdds[i], inames, filename);
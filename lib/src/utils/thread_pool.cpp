@@ -0,0 +1,119 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <lydia/utils/thread_pool.hpp>
+
+namespace whitemech::lydia {
+
+ThreadPool::ThreadPool(size_t nb_threads) {
+  if (nb_threads == 0)
+    nb_threads = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t i = 1; i < nb_threads; i++)
+    workers_.emplace_back([this]() { worker_loop_(); });
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& worker : workers_)
+    worker.join();
+}
+
+void ThreadPool::worker_loop_() {
+  uint64_t seen = 0;
+  while (true) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_available_.wait(lock,
+                         [&]() { return stop_ || generation_ != seen; });
+    if (stop_)
+      return;
+    seen = generation_;
+    const body_t* body = body_;
+    size_t nb_items = nb_items_;
+    size_t chunk_size = chunk_size_;
+    ++nb_busy_;
+    lock.unlock();
+
+    run_chunks_(body, nb_items, chunk_size);
+
+    lock.lock();
+    if (--nb_busy_ == 0)
+      work_done_.notify_all();
+  }
+}
+
+void ThreadPool::run_chunks_(const body_t* body, size_t nb_items,
+                             size_t chunk_size) {
+  if (body == nullptr)
+    return;
+  while (true) {
+    size_t begin = next_chunk_.fetch_add(1) * chunk_size;
+    if (begin >= nb_items)
+      return;
+    try {
+      (*body)(begin, std::min(begin + chunk_size, nb_items));
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_)
+        error_ = std::current_exception();
+    }
+  }
+}
+
+void ThreadPool::parallel_for(size_t nb_items, size_t chunk_size,
+                              const body_t& body) {
+  chunk_size = std::max<size_t>(chunk_size, 1);
+  if (nb_items == 0)
+    return;
+  if (workers_.empty() || nb_items <= chunk_size) {
+    for (size_t begin = 0; begin < nb_items; begin += chunk_size)
+      body(begin, std::min(begin + chunk_size, nb_items));
+    return;
+  }
+
+  std::lock_guard<std::mutex> loop_lock(loop_mutex_);
+  {
+    // a worker may still be leaving the previous loop.
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [&]() { return nb_busy_ == 0; });
+    body_ = &body;
+    nb_items_ = nb_items;
+    chunk_size_ = chunk_size;
+    next_chunk_ = 0;
+    error_ = nullptr;
+    ++generation_;
+  }
+  work_available_.notify_all();
+
+  run_chunks_(&body, nb_items, chunk_size);
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [&]() { return nb_busy_ == 0; });
+    body_ = nullptr;
+    error = error_;
+    error_ = nullptr;
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+} // namespace whitemech::lydia
@@ -0,0 +1,90 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <lydia/logic/atom_ordering.hpp>
+#include <lydia/to_dfa/strategies/bdd/base.hpp>
+#include <lydia/to_dfa/strategies/compositional/base.hpp>
+
+namespace whitemech::lydia::Test {
+
+static std::vector<std::string> to_names(const std::vector<atom_ptr>& atoms) {
+  auto names = std::vector<std::string>();
+  for (const auto& atom : atoms)
+    names.push_back(atom->str());
+  return names;
+}
+
+TEST_CASE("Lexicographic ordering", "[atom_ordering]") {
+  auto formula = parse_ldlf("<c ; a>tt & <b>tt");
+  auto atoms = find_atoms(*formula);
+  auto order = LexicographicOrdering().order(*formula, atoms);
+  REQUIRE(to_names(order) == std::vector<std::string>({"a", "b", "c"}));
+}
+
+TEST_CASE("FORCE ordering", "[atom_ordering]") {
+  auto formula = parse_ldlf("<a ; z>tt & <z ; b>tt & <b ; y>tt");
+  auto atoms = find_atoms(*formula);
+  auto hyperedges = atom_hyperedges(*formula);
+  REQUIRE(hyperedges.size() == 3);
+
+  auto lexicographic = LexicographicOrdering().order(*formula, atoms);
+  auto order = ForceOrdering().order(*formula, atoms);
+  REQUIRE(order.size() == atoms.size());
+  REQUIRE(set_atoms_ptr(order.begin(), order.end()) == atoms);
+  REQUIRE(total_span(lexicographic, hyperedges) == 6);
+  REQUIRE(total_span(order, hyperedges) < 6);
+}
+
+TEST_CASE("Interleaved ordering", "[atom_ordering]") {
+  auto formula = parse_ldlf("<a ; x>tt & <b ; y>tt & <c ; d>tt");
+  auto atoms = find_atoms(*formula);
+  auto ordering =
+      InterleavedOrdering({{"a", "b", "c", "unknown"}, {"x", "y"}});
+  auto order = ordering.order(*formula, atoms);
+  REQUIRE(to_names(order) ==
+          std::vector<std::string>({"a", "x", "b", "y", "c", "d"}));
+}
+
+TEST_CASE("Translation with atom ordering", "[atom_ordering][to_dfa]") {
+  auto formula = parse_ldlf("<a ; z>tt");
+  auto ordering = std::make_shared<InterleavedOrdering>(
+      std::vector<std::vector<std::string>>({{"z"}}));
+
+  SECTION("Compositional strategy") {
+    auto strategy = CompositionalStrategy();
+    strategy.atom_ordering = ordering;
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    REQUIRE(to_names(strategy.id2atoms) ==
+            std::vector<std::string>({"z", "a"}));
+    REQUIRE(verify(*automaton, {"10", "01"}, true));
+    REQUIRE(verify(*automaton, {"01", "10"}, false));
+  }
+
+  SECTION("BDD strategy") {
+    auto mgr = CUDD::Cudd();
+    auto strategy = BDDStrategy(mgr);
+    strategy.atom_ordering = ordering;
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    REQUIRE(to_names(strategy.id2atoms) ==
+            std::vector<std::string>({"z", "a"}));
+    REQUIRE(verify(*automaton, {"10", "01"}, true));
+    REQUIRE(verify(*automaton, {"01", "10"}, false));
+  }
+}
+
+} // namespace whitemech::lydia::Test
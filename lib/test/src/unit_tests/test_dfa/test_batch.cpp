@@ -0,0 +1,135 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <cuddObj.hh>
+#include <lydia/dfa/batch.hpp>
+#include <stdexcept>
+
+namespace whitemech::lydia::Test {
+
+/*
+ * All the traces up to the given length, over two variables.
+ */
+static std::vector<trace> all_traces(int max_length) {
+  std::vector<trace> result;
+  for (int length = 0; length <= max_length; length++) {
+    for (int code = 0; code < (1 << (2 * length)); code++) {
+      trace word;
+      for (int k = 0; k < length; k++)
+        word.push_back({(code >> (2 * k)) & 1, (code >> (2 * k + 1)) & 1});
+      result.push_back(word);
+    }
+  }
+  return result;
+}
+
+TEST_CASE("Trace buffer", "[dfa][batch]") {
+  auto buffer = TraceBuffer(70);
+  REQUIRE(buffer.get_words_per_symbol() == 2);
+  interpretation symbol(70, 0);
+  symbol[3] = 1;
+  symbol[69] = 1;
+  buffer.add_trace(trace{});
+  buffer.add_trace({symbol, interpretation(70, 0)});
+  REQUIRE(buffer.get_nb_traces() == 2);
+  REQUIRE(buffer.get_nb_symbols() == 2);
+  REQUIRE(buffer.get_trace_begin(1) == 0);
+  REQUIRE(buffer.get_trace_end(1) == 2);
+  REQUIRE(buffer.get_value(0, 3));
+  REQUIRE(buffer.get_value(0, 69));
+  REQUIRE_FALSE(buffer.get_value(0, 4));
+  REQUIRE_FALSE(buffer.get_value(1, 3));
+
+  REQUIRE_THROWS_AS(TraceBuffer(2, {0, 0}, {0, 1}), std::invalid_argument);
+  REQUIRE_THROWS_AS(TraceBuffer(2, {0}, {1}), std::invalid_argument);
+  REQUIRE(TraceBuffer(2, {1, 2, 3}, {0, 1, 3}).get_nb_traces() == 2);
+}
+
+TEST_CASE("Batch trace acceptance", "[dfa][batch]") {
+  auto formula_string =
+      GENERATE(std::string("<a ; b>tt"), std::string("[true*]<a + b>tt"),
+               std::string("<(a ; b)*>end"), std::string("<true*><a & b>tt"));
+  auto formula = parse_ldlf(formula_string);
+  auto words = all_traces(5);
+  auto buffer = TraceBuffer(2);
+  for (const auto& word : words)
+    buffer.add_trace(word);
+
+  auto check = [&](const abstract_dfa& automaton, ThreadPool* pool,
+                   const StateClassification* classification) {
+    auto verdicts = accepts_many(automaton, buffer, pool, classification);
+    REQUIRE(verdicts.size() == words.size());
+    size_t nb_accepted = 0;
+    for (size_t t = 0; t < words.size(); t++) {
+      REQUIRE(verdicts[t] == automaton.accepts(words[t]));
+      nb_accepted += verdicts[t];
+    }
+    REQUIRE(verdicts.count() == nb_accepted);
+  };
+
+  SECTION("MONA DFA") {
+    auto strategy = CompositionalStrategy();
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    auto classification =
+        classify_states(dynamic_cast<const mona_dfa&>(*automaton));
+    auto pool = ThreadPool(4);
+    check(*automaton, nullptr, nullptr);
+    check(*automaton, &pool, nullptr);
+    check(*automaton, &pool, &classification);
+  }
+
+  SECTION("CUDD DFA") {
+    auto mgr = CUDD::Cudd();
+    auto strategy = BDDStrategy(mgr);
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    auto classification =
+        classify_states(dynamic_cast<const dfa&>(*automaton));
+    auto pool = ThreadPool(4);
+    check(*automaton, &pool, nullptr);
+    check(*automaton, nullptr, &classification);
+  }
+
+  SECTION("Too few variables") {
+    auto strategy = CompositionalStrategy();
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    REQUIRE_THROWS_AS(accepts_many(*automaton, TraceBuffer(1)),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Thread pool", "[utils][thread_pool]") {
+  auto pool = ThreadPool(4);
+  REQUIRE(pool.get_nb_threads() == 4);
+  std::vector<int> values(10000, 0);
+  for (int round = 0; round < 3; round++) {
+    pool.parallel_for(values.size(), 100, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++)
+        values[i] += 1;
+    });
+  }
+  REQUIRE(std::all_of(values.begin(), values.end(),
+                      [](int value) { return value == 3; }));
+  REQUIRE_THROWS_AS(pool.parallel_for(10, 1,
+                                      [](size_t begin, size_t) {
+                                        if (begin == 5)
+                                          throw std::runtime_error("error");
+                                      }),
+                    std::runtime_error);
+}
+
+} // namespace whitemech::lydia::Test
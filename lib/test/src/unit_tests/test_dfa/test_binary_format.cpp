@@ -0,0 +1,121 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <cuddObj.hh>
+#include <lydia/dfa/binary_format.hpp>
+#include <lydia/dfa/dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
+#include <sstream>
+
+namespace whitemech::lydia::Test {
+
+static MonaDFAFile parse_content(const std::string& content) {
+  return parse_binary_dfa(content.data(), content.data() + content.size());
+}
+
+TEST_CASE("Binary DFA from MONA DFA file", "[dfa][binary_format]") {
+  std::string text = "MONA DFA\n"
+                     "number of variables: 2\n"
+                     "variables: P Q\n"
+                     "orders: 2 2\n"
+                     "states: 3\n"
+                     "initial: 0\n"
+                     "bdd nodes: 4\n"
+                     "final: 0 1 -1\n"
+                     "behaviour: 0 1 3\n"
+                     "bdd:\n"
+                     " -1 1 0\n"
+                     " 0 0 2\n"
+                     " 1 3 0\n"
+                     " -1 2 0\n"
+                     "end\n";
+  auto file = parse_mona_dfa(text.data(), text.data() + text.size());
+  std::stringstream stream;
+  write_binary_dfa(stream, file);
+  auto content = stream.str();
+
+  SECTION("Round trip") {
+    auto result = parse_content(content);
+    REQUIRE(result.variables == file.variables);
+    REQUIRE(result.nb_states == 3);
+    REQUIRE(result.initial_state == 0);
+    REQUIRE(result.final_states == std::vector<int>({1}));
+    // the nodes are renumbered in post-order.
+    REQUIRE(result.get_nb_nodes() == 4);
+    REQUIRE(result.bdd_nodes ==
+            std::vector<int>({-1, 1, 0, -1, 2, 0, 1, 1, 0, 0, 0, 2}));
+    REQUIRE(result.behaviour == std::vector<int>({0, 3, 1}));
+  }
+
+  SECTION("Bad magic number") {
+    content[0] = 'X';
+    REQUIRE_THROWS_AS(parse_content(content), std::runtime_error);
+  }
+
+  SECTION("Unsupported version") {
+    content[8] = 42;
+    REQUIRE_THROWS_AS(parse_content(content), std::runtime_error);
+  }
+
+  SECTION("Truncated file") {
+    content.pop_back();
+    REQUIRE_THROWS_AS(parse_content(content), std::runtime_error);
+  }
+
+  SECTION("Missing file") {
+    REQUIRE_THROWS_AS(parse_binary_dfa_file("this-file-does-not-exist.bin"),
+                      std::runtime_error);
+  }
+}
+
+TEST_CASE("Binary DFA round trip", "[dfa][binary_format]") {
+  auto formula_string =
+      GENERATE(std::string("<a ; b ; c>tt"), std::string("[true*]<a + b>tt"),
+               std::string("<(a ; b)*>end & !(<true*><c>tt)"));
+  auto formula = parse_ldlf(formula_string);
+
+  auto strategy = CompositionalStrategy();
+  auto automaton = Translator(strategy).to_dfa(*formula);
+  auto mona = std::dynamic_pointer_cast<mona_dfa>(automaton);
+  REQUIRE(mona != nullptr);
+  int nb_variables = mona->get_nb_variables();
+
+  SECTION("MONA DFA") {
+    std::stringstream stream;
+    write_binary_dfa(stream, *mona);
+    auto file = parse_content(stream.str());
+    REQUIRE(file.variables == mona->names);
+    auto result = mona_dfa(mona_dfa_from_file(file), file.variables);
+    REQUIRE(result.get_nb_states() == mona->get_nb_states());
+    REQUIRE(compare<3>(result, *mona, nb_variables));
+  }
+
+  SECTION("Symbolic DFA") {
+    auto mgr = CUDD::Cudd();
+    auto symbolic = dfa(mgr, *mona);
+    std::stringstream stream;
+    write_binary_dfa(stream, symbolic);
+    auto file = parse_content(stream.str());
+    auto result = dfa(mgr, file);
+    REQUIRE(result.get_nb_states() == symbolic.get_nb_states());
+    REQUIRE(result.variables == symbolic.variables);
+    REQUIRE(compare<3>(result, *mona, nb_variables));
+  }
+}
+
+} // namespace whitemech::lydia::Test
@@ -0,0 +1,106 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <cuddObj.hh>
+#include <lydia/dfa/classification.hpp>
+
+namespace whitemech::lydia::Test {
+
+/*
+ * Classify a state by exploring the states reachable from it.
+ */
+static StateClass expected_class(const abstract_dfa& automaton, int state) {
+  const int nb_variables = automaton.get_nb_variables();
+  std::vector<bool> visited(automaton.get_nb_states(), false);
+  std::vector<int> stack{state};
+  bool final_found = false;
+  bool non_final_found = false;
+  while (!stack.empty()) {
+    int s = stack.back();
+    stack.pop_back();
+    if (visited[s])
+      continue;
+    visited[s] = true;
+    if (automaton.is_final(s))
+      final_found = true;
+    else
+      non_final_found = true;
+    for (int code = 0; code < (1 << nb_variables); code++) {
+      interpretation symbol(nb_variables);
+      for (int i = 0; i < nb_variables; i++)
+        symbol[i] = (code >> i) & 1;
+      stack.push_back(automaton.get_successor(s, symbol));
+    }
+  }
+  if (!non_final_found)
+    return StateClass::accepting_sink;
+  if (!final_found)
+    return StateClass::rejecting_sink;
+  return StateClass::live;
+}
+
+TEST_CASE("State classification", "[dfa][classification]") {
+  auto formula_string =
+      GENERATE(std::string("<a ; b>tt"), std::string("[true*]<a + b>tt"),
+               std::string("<(a ; b)*>end"), std::string("<true*><a & b>tt"),
+               std::string("[a ; b]ff"));
+  auto formula = parse_ldlf(formula_string);
+  auto mgr = CUDD::Cudd();
+
+  auto check = [](const auto& automaton) {
+    auto classification = classify_states(automaton);
+    REQUIRE(classification.get_nb_states() == automaton.get_nb_states());
+    for (int s = 0; s < automaton.get_nb_states(); s++)
+      REQUIRE(classification.get_class(s) == expected_class(automaton, s));
+
+    for (int length = 0; length <= 4; length++) {
+      for (int code = 0; code < (1 << (2 * length)); code++) {
+        trace word;
+        for (int k = 0; k < length; k++)
+          word.push_back({(code >> (2 * k)) & 1, (code >> (2 * k + 1)) & 1});
+        REQUIRE(accepts(automaton, classification, word) ==
+                automaton.accepts(word));
+      }
+    }
+  };
+
+  SECTION("MONA DFA") {
+    auto strategy = CompositionalStrategy();
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    check(dynamic_cast<const mona_dfa&>(*automaton));
+  }
+
+  SECTION("CUDD DFA") {
+    auto strategy = BDDStrategy(mgr);
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    check(dynamic_cast<const dfa&>(*automaton));
+  }
+}
+
+TEST_CASE("State classification of an explicit graph",
+          "[dfa][classification]") {
+  // 0 -> 1 -> 2 -> 2, 0 -> 3 -> 3, 2 final.
+  auto classification =
+      classify_states({{1, 3}, {2}, {2, 2}, {3}}, {false, false, true, false});
+  REQUIRE(classification.is_live(0));
+  REQUIRE(classification.is_live(1));
+  REQUIRE(classification.is_accepting_sink(2));
+  REQUIRE(classification.is_rejecting_sink(3));
+}
+
+} // namespace whitemech::lydia::Test
@@ -0,0 +1,117 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <cuddObj.hh>
+#include <lydia/dfa/batch.hpp>
+#include <lydia/dfa/compiled_dfa.hpp>
+#include <stdexcept>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("Compiled DFA", "[dfa][compiled_dfa]") {
+  auto formula_string = GENERATE(
+      std::string("<a ; b>tt"), std::string("[true*]<a + b>tt"),
+      std::string("<(a ; b)*>end"), std::string("<true*><a & !c>tt"),
+      std::string("<true*><b ; !a>end"));
+  auto formula = parse_ldlf(formula_string);
+  auto mgr = CUDD::Cudd();
+
+  auto check = [](const abstract_dfa& automaton) {
+    auto compiled = compiled_dfa(automaton);
+    const int nb_variables = automaton.get_nb_variables();
+    REQUIRE(compiled.get_nb_states() == automaton.get_nb_states());
+    REQUIRE(compiled.get_nb_variables() == nb_variables);
+    REQUIRE(compiled.get_initial_state() == automaton.get_initial_state());
+    REQUIRE(compiled.get_table_size() ==
+            (sizeof(uint16_t) * automaton.get_nb_states() << nb_variables));
+    for (int s = 0; s < automaton.get_nb_states(); s++) {
+      REQUIRE(compiled.is_final(s) == automaton.is_final(s));
+      for (uint32_t code = 0; code < (1u << nb_variables); code++) {
+        interpretation symbol(nb_variables);
+        for (int i = 0; i < nb_variables; i++)
+          symbol[i] = (code >> i) & 1;
+        REQUIRE(compiled_dfa::encode(symbol) == code);
+        REQUIRE(compiled.get_successor(s, code) ==
+                automaton.get_successor(s, symbol));
+      }
+    }
+
+    auto buffer = TraceBuffer(nb_variables);
+    std::vector<bool> expected;
+    for (int length = 0; length <= 4; length++) {
+      for (uint32_t code = 0; code < (1u << (nb_variables * length));
+           code++) {
+        std::vector<uint32_t> word;
+        trace unpacked;
+        for (int k = 0; k < length; k++) {
+          uint32_t symbol = (code >> (nb_variables * k)) &
+                            ((1u << nb_variables) - 1);
+          word.push_back(symbol);
+          unpacked.emplace_back(nb_variables);
+          for (int i = 0; i < nb_variables; i++)
+            unpacked.back()[i] = (symbol >> i) & 1;
+        }
+        REQUIRE(compiled.accepts(word) == automaton.accepts(unpacked));
+        REQUIRE(compiled.accepts(unpacked) == automaton.accepts(unpacked));
+        buffer.add_trace(unpacked);
+        expected.push_back(automaton.accepts(unpacked));
+      }
+    }
+    auto pool = ThreadPool(2);
+    auto verdicts = accepts_many(compiled, buffer, &pool);
+    for (size_t t = 0; t < expected.size(); t++)
+      REQUIRE(verdicts[t] == expected[t]);
+  };
+
+  SECTION("From a MONA DFA") {
+    auto strategy = CompositionalStrategy();
+    check(*Translator(strategy).to_dfa(*formula));
+  }
+
+  SECTION("From a CUDD DFA") {
+    auto strategy = BDDStrategy(mgr);
+    check(*Translator(strategy).to_dfa(*formula));
+  }
+}
+
+TEST_CASE("Compiled DFA extra variables", "[dfa][compiled_dfa]") {
+  auto formula = parse_ldlf("<a ; b>tt");
+  auto strategy = CompositionalStrategy();
+  auto compiled = compiled_dfa(*Translator(strategy).to_dfa(*formula));
+  const int s = compiled.get_initial_state();
+  REQUIRE(compiled.get_successor(s, interpretation{1, 0, 1, 1}) ==
+          compiled.get_successor(s, interpretation{1, 0}));
+  REQUIRE(compiled.get_successor(s, interpretation_set{0, 3, 7}) ==
+          compiled.get_successor(s, interpretation_set{0}));
+  REQUIRE(compiled.accepts(trace{{1, 0, 1}, {0, 1, 1}}) ==
+          compiled.accepts(trace{{1, 0}, {0, 1}}));
+}
+
+TEST_CASE("Compiled DFA errors", "[dfa][compiled_dfa]") {
+  auto mgr = CUDD::Cudd();
+  auto too_many_variables =
+      dfa(mgr, 1, compiled_dfa::MAX_NB_VARIABLES + 1);
+  REQUIRE_THROWS_AS(compiled_dfa(too_many_variables), std::invalid_argument);
+
+  auto automaton = dfa(mgr, 1, 2);
+  auto compiled = compiled_dfa(automaton);
+  REQUIRE_THROWS_AS(compiled.add_state(), std::logic_error);
+  REQUIRE_THROWS_AS(compiled.set_final_state(0), std::logic_error);
+}
+
+} // namespace whitemech::lydia::Test
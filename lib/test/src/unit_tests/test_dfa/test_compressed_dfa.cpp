@@ -0,0 +1,151 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <cuddObj.hh>
+#include <lydia/dfa/batch.hpp>
+#include <lydia/dfa/compressed_dfa.hpp>
+
+namespace whitemech::lydia::Test {
+
+static std::vector<int> successors(const abstract_dfa& automaton,
+                                   const interpretation& symbol) {
+  std::vector<int> result;
+  for (int s = 0; s < automaton.get_nb_states(); s++)
+    result.push_back(automaton.get_successor(s, symbol));
+  return result;
+}
+
+static void check_compressed(const abstract_dfa& automaton,
+                             const compressed_dfa& compressed) {
+  const int nb_variables = automaton.get_nb_variables();
+  const auto& classifier = compressed.get_classifier();
+  REQUIRE(compressed.get_nb_states() == automaton.get_nb_states());
+  REQUIRE(compressed.get_initial_state() == automaton.get_initial_state());
+  for (int s = 0; s < automaton.get_nb_states(); s++)
+    REQUIRE(compressed.is_final(s) == automaton.is_final(s));
+
+  // the classes are the coarsest partition: the interpretations of the
+  // same class have the same successors, and the representatives of
+  // different classes have different ones.
+  std::set<std::vector<int>> behaviours;
+  for (int c = 0; c < compressed.get_nb_classes(); c++) {
+    const auto& representative = classifier.get_representative(c);
+    REQUIRE(classifier.classify(representative) == c);
+    behaviours.insert(successors(automaton, representative));
+  }
+  REQUIRE((int)behaviours.size() == compressed.get_nb_classes());
+
+  for (uint32_t code = 0; code < (1u << nb_variables); code++) {
+    interpretation symbol(nb_variables);
+    for (int i = 0; i < nb_variables; i++)
+      symbol[i] = (code >> i) & 1;
+    uint64_t packed = code;
+    int c = classifier.classify(&packed);
+    REQUIRE(classifier.classify(symbol) == c);
+    REQUIRE(successors(automaton, symbol) ==
+            successors(automaton, classifier.get_representative(c)));
+    for (int s = 0; s < automaton.get_nb_states(); s++)
+      REQUIRE(compressed.get_successor(s, symbol) ==
+              automaton.get_successor(s, symbol));
+  }
+}
+
+TEST_CASE("Compressed DFA", "[dfa][compressed_dfa]") {
+  auto formula_string = GENERATE(
+      std::string("<a ; b>tt"), std::string("[true*]<a + b>tt"),
+      std::string("<(a ; b)*>end"), std::string("<true*><a & !c>tt"),
+      std::string("<true*><b ; !a>end"));
+  auto formula = parse_ldlf(formula_string);
+
+  SECTION("From a MONA DFA") {
+    auto strategy = CompositionalStrategy();
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    auto compressed =
+        compressed_dfa(dynamic_cast<const mona_dfa&>(*automaton));
+    check_compressed(*automaton, compressed);
+  }
+
+  SECTION("From a CUDD DFA") {
+    auto mgr = CUDD::Cudd();
+    auto strategy = BDDStrategy(mgr);
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    auto compressed = compressed_dfa(dynamic_cast<const dfa&>(*automaton));
+    check_compressed(*automaton, compressed);
+  }
+}
+
+TEST_CASE("Compressed DFA with many variables", "[dfa][compressed_dfa]") {
+  const int nb_atoms = 24;
+  std::string guard = "a0";
+  for (int i = 1; i < nb_atoms; i++)
+    guard += " & a" + std::to_string(i);
+  auto formula = parse_ldlf("<true*><" + guard + ">end");
+  auto strategy = CompositionalStrategy();
+  auto automaton = Translator(strategy).to_dfa(*formula);
+  auto compressed = compressed_dfa(dynamic_cast<const mona_dfa&>(*automaton));
+  REQUIRE(compressed.get_nb_variables() == nb_atoms);
+  // either all the atoms are true, or not.
+  REQUIRE(compressed.get_nb_classes() == 2);
+
+  interpretation all_true(nb_atoms, 1);
+  interpretation one_false(nb_atoms, 1);
+  one_false[7] = 0;
+  std::vector<trace> words = {{},
+                              {all_true},
+                              {one_false},
+                              {all_true, one_false},
+                              {one_false, all_true}};
+  auto buffer = TraceBuffer(nb_atoms);
+  for (const auto& word : words) {
+    REQUIRE(compressed.accepts(word) == automaton->accepts(word));
+    buffer.add_trace(word);
+  }
+  auto verdicts = accepts_many(compressed, buffer);
+  for (size_t t = 0; t < words.size(); t++)
+    REQUIRE(verdicts[t] == automaton->accepts(words[t]));
+}
+
+TEST_CASE("Compressed DFA with short symbols", "[dfa][compressed_dfa]") {
+  // more variables than the inline words of interpretation_bits.
+  const int nb_atoms = 130;
+  std::string guard = "a0";
+  for (int i = 1; i < nb_atoms; i++)
+    guard += " & !a" + std::to_string(i);
+  auto formula = parse_ldlf("<true*><" + guard + ">end");
+  auto strategy = CompositionalStrategy();
+  auto automaton = Translator(strategy).to_dfa(*formula);
+  auto compressed = compressed_dfa(dynamic_cast<const mona_dfa&>(*automaton));
+  REQUIRE(compressed.get_nb_variables() == nb_atoms);
+
+  // the missing variables are false.
+  for (size_t size : {0, 1, 64, 129}) {
+    for (bool first : {false, true}) {
+      interpretation_bits symbol(size);
+      interpretation padded(nb_atoms, 0);
+      if (first && size > 0) {
+        symbol.set(0);
+        padded[0] = 1;
+      }
+      for (int s = 0; s < automaton->get_nb_states(); s++)
+        REQUIRE(compressed.get_successor(s, symbol) ==
+                automaton->get_successor(s, padded));
+    }
+  }
+}
+
+} // namespace whitemech::lydia::Test
@@ -14,9 +14,11 @@
  * You should have received a copy of the GNU Lesser General Public License
  * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include "test/src/utils/to_dfa.hpp"
 #include <catch.hpp>
 #include <cuddObj.hh>
 #include <lydia/dfa/dfa.hpp>
+#include <lydia/dfa/mona_dfa.hpp>
 
 namespace whitemech::lydia::Test {
 
@@ -286,6 +288,56 @@ TEST_CASE("Incremental construction", "[dfa]") {
       REQUIRE(!my_dfa.accepts(t_a_a));
     }
   }
+
+  SECTION("New bits are added on demand.") {
+    auto mgr = CUDD::Cudd();
+    auto my_dfa = dfa(mgr, 1, 1);
+    REQUIRE(my_dfa.nb_bits == 1);
+
+    // the chain 1 -a-> 2 -a-> 3 -a-> 4, with 4 final.
+    // transitions are added while new states (and bits) are being added.
+    my_dfa.set_initial_state(my_dfa.add_state());
+    for (int state = 2; state <= 4; state++) {
+      REQUIRE(my_dfa.add_state() == state);
+      my_dfa.add_transition(state - 1, interpretation_set{0}, state, true);
+    }
+    my_dfa.set_final_state(4, true);
+    REQUIRE(my_dfa.nb_bits == 3);
+    REQUIRE(my_dfa.get_nb_states() == 5);
+
+    REQUIRE(my_dfa.get_successor(1, t_a[0]) == 2);
+    REQUIRE(my_dfa.get_successor(2, t_a[0]) == 3);
+    REQUIRE(my_dfa.get_successor(3, t_a[0]) == 4);
+    REQUIRE(my_dfa.get_successor(3, t_na[0]) == 0);
+    REQUIRE(my_dfa.get_successor(4, t_a[0]) == 0);
+    REQUIRE(!my_dfa.is_final(1));
+    REQUIRE(my_dfa.is_final(4));
+
+    REQUIRE(!my_dfa.accepts(t_));
+    REQUIRE(!my_dfa.accepts(t_a_a));
+    REQUIRE(my_dfa.accepts(trace{a, a, a}));
+    REQUIRE(!my_dfa.accepts(trace{a, na, a}));
+    REQUIRE(!my_dfa.accepts(trace{a, a, a, a}));
+  }
+}
+
+TEST_CASE("Conversion from MONA DFA", "[dfa][mona_dfa]") {
+  auto formula_string =
+      GENERATE(std::string("<a ; b ; c>tt"), std::string("[true*]<a + b>tt"),
+               std::string("<(a ; b)*>end & !(<true*><c>tt)"));
+  auto formula = parse_ldlf(formula_string);
+
+  auto strategy = CompositionalStrategy();
+  auto automaton = Translator(strategy).to_dfa(*formula);
+  auto mona = std::dynamic_pointer_cast<mona_dfa>(automaton);
+  REQUIRE(mona != nullptr);
+
+  auto mgr = CUDD::Cudd();
+  auto converted = dfa(mgr, *mona);
+  REQUIRE(converted.get_nb_states() == mona->get_nb_states());
+  REQUIRE(converted.get_nb_variables() == mona->get_nb_variables());
+  REQUIRE(converted.variables == mona->names);
+  REQUIRE(compare<3>(converted, *mona, mona->get_nb_variables()));
 }
 
 } // namespace whitemech::lydia::Test
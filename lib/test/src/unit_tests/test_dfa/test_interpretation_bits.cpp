@@ -0,0 +1,130 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <cuddObj.hh>
+#include <lydia/dfa/batch.hpp>
+#include <lydia/dfa/compiled_dfa.hpp>
+#include <lydia/dfa/compressed_dfa.hpp>
+#include <lydia/dfa/interpretation_bits.hpp>
+#include <stdexcept>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("Interpretation bits", "[dfa][interpretation_bits]") {
+  auto size = GENERATE(0, 3, 64, 130, 300);
+  auto symbol = interpretation_bits(size);
+  REQUIRE(symbol.size() == (size_t)size);
+  REQUIRE(symbol.get_nb_words() == (size_t)(size + 63) / 64);
+  for (int i = 0; i < size; i++)
+    REQUIRE_FALSE(symbol[i]);
+  REQUIRE_FALSE(symbol.test(size));
+
+  interpretation expected(size, 0);
+  for (int i = 0; i < size; i += 3) {
+    symbol.set(i);
+    expected[i] = 1;
+  }
+  if (size > 0) {
+    symbol.set(0, false);
+    expected[0] = 0;
+  }
+  REQUIRE(symbol.to_interpretation() == expected);
+  REQUIRE(interpretation_bits(expected) == symbol);
+
+  interpretation_set true_variables;
+  for (int i = 0; i < size; i++)
+    if (expected[i])
+      true_variables.insert(i);
+  true_variables.insert(size + 5);
+  REQUIRE(interpretation_bits(size, true_variables) == symbol);
+
+  auto copy = symbol;
+  symbol.clear();
+  REQUIRE(symbol == interpretation_bits(size));
+  REQUIRE(copy.to_interpretation() == expected);
+  REQUIRE(interpretation_bits(size + 1) != interpretation_bits(size));
+}
+
+TEST_CASE("Successor of a symbol", "[dfa][interpretation_bits]") {
+  auto formula_string =
+      GENERATE(std::string("<a ; b>tt"), std::string("[true*]<a + b>tt"),
+               std::string("<(a ; b)*>end"), std::string("<true*><a & b>tt"));
+  auto formula = parse_ldlf(formula_string);
+  auto mgr = CUDD::Cudd();
+
+  auto check = [](const abstract_dfa& automaton) {
+    for (int s = 0; s < automaton.get_nb_states(); s++) {
+      for (int code = 0; code < 4; code++) {
+        interpretation symbol{code & 1, (code >> 1) & 1};
+        interpretation_set true_variables;
+        for (int i = 0; i < 2; i++)
+          if (symbol[i])
+            true_variables.insert(i);
+        int expected = automaton.get_successor(s, symbol);
+        REQUIRE(automaton.get_successor(s, true_variables) == expected);
+        REQUIRE(automaton.get_successor(s, interpretation_bits(symbol)) ==
+                expected);
+      }
+    }
+
+    auto buffer = TraceBuffer(2);
+    std::vector<bool> expected;
+    for (int length = 0; length <= 4; length++) {
+      for (int code = 0; code < (1 << (2 * length)); code++) {
+        trace word;
+        trace_bits word_bits;
+        for (int k = 0; k < length; k++) {
+          word.push_back({(code >> (2 * k)) & 1, (code >> (2 * k + 1)) & 1});
+          word_bits.emplace_back(word.back());
+        }
+        REQUIRE(automaton.accepts(word_bits) == automaton.accepts(word));
+        buffer.add_trace(word_bits);
+        expected.push_back(automaton.accepts(word));
+      }
+    }
+    auto verdicts = accepts_many(automaton, buffer);
+    for (size_t t = 0; t < expected.size(); t++)
+      REQUIRE(verdicts[t] == expected[t]);
+  };
+
+  SECTION("MONA DFA") {
+    auto strategy = CompositionalStrategy();
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    const auto& mona = dynamic_cast<const mona_dfa&>(*automaton);
+    check(mona);
+    check(compiled_dfa(mona));
+    check(compressed_dfa(mona));
+  }
+
+  SECTION("CUDD DFA") {
+    auto strategy = BDDStrategy(mgr);
+    auto automaton = Translator(strategy).to_dfa(*formula);
+    check(*automaton);
+  }
+}
+
+TEST_CASE("MONA DFA is read-only", "[dfa][interpretation_bits]") {
+  auto strategy = CompositionalStrategy();
+  auto automaton = Translator(strategy).to_dfa(*parse_ldlf("<a>tt"));
+  REQUIRE_THROWS_AS(automaton->add_state(), std::logic_error);
+  REQUIRE_THROWS_AS(automaton->set_final_state(0), std::logic_error);
+  REQUIRE_THROWS_AS(automaton->add_transition(0, interpretation_set{}, 0),
+                    std::logic_error);
+}
+
+} // namespace whitemech::lydia::Test
@@ -29,6 +29,34 @@ TEST_CASE("Test is sink", "[dfa][is_sink]") {
   REQUIRE(!is_sink(dfaLDLfFalse(), true));
 }
 
+/*
+ * A DFA with two states, without variables: state 0 goes to the
+ * given successor, state 1 loops.
+ */
+static DFA* two_states_dfa(int successor, const char* statuses) {
+  dfaSetup(2, 0, nullptr);
+  dfaAllocExceptions(0);
+  dfaStoreState(successor);
+  dfaAllocExceptions(0);
+  dfaStoreState(1);
+  return dfaBuild(const_cast<char*>(statuses));
+}
+
+TEST_CASE("Test is sink without minimization", "[dfa][is_sink]") {
+  DFA* accepting = two_states_dfa(1, "++");
+  DFA* rejecting = two_states_dfa(1, "--");
+  DFA* unreachable = two_states_dfa(0, "+-");
+  DFA* live = two_states_dfa(1, "+-");
+  REQUIRE(is_sink(accepting, true));
+  REQUIRE(!is_sink(accepting, false));
+  REQUIRE(is_sink(rejecting, false));
+  REQUIRE(is_sink(unreachable, true));
+  REQUIRE(!is_sink(live, true));
+  REQUIRE(!is_sink(live, false));
+  for (DFA* automaton : {accepting, rejecting, unreachable, live})
+    dfaFree(automaton);
+}
+
 TEST_CASE("Test MONA dfa_concatenate", "[dfa][mona_dfa][concatenation]") {
   bdd_init();
   int var = 2;
@@ -0,0 +1,83 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <lydia/dfa/mona_file.hpp>
+#include <utility>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("Parse MONA DFA", "[dfa][mona_file]") {
+  std::string content = "MONA DFA\n"
+                        "number of variables: 2\n"
+                        "variables: P Q\n"
+                        "orders: 2 2\n"
+                        "states: 3\n"
+                        "initial: 0\n"
+                        "bdd nodes: 4\n"
+                        "final: 0 1 -1\n"
+                        "behaviour: 0 1 3\n"
+                        "bdd:\n"
+                        " -1 1 0\n"
+                        " 0 0 2\n"
+                        " 1 3 0\n"
+                        " -1 2 0\n"
+                        "end\n";
+
+  SECTION("Well-formed file") {
+    auto file = parse_mona_dfa(content.data(), content.data() + content.size());
+    REQUIRE(file.variables == std::vector<std::string>({"P", "Q"}));
+    REQUIRE(file.nb_states == 3);
+    REQUIRE(file.initial_state == 0);
+    REQUIRE(file.final_states == std::vector<int>({1}));
+    REQUIRE(file.behaviour == std::vector<int>({0, 1, 3}));
+    REQUIRE(file.get_nb_nodes() == 4);
+    REQUIRE(file.bdd_nodes ==
+            std::vector<int>({-1, 1, 0, 0, 0, 2, 1, 3, 0, -1, 2, 0}));
+  }
+
+  SECTION("Truncated file") {
+    auto truncated = content.substr(0, content.find(" 1 3 0"));
+    REQUIRE_THROWS_AS(
+        parse_mona_dfa(truncated.data(), truncated.data() + truncated.size()),
+        std::runtime_error);
+  }
+
+  SECTION("Inconsistent file") {
+    auto [from, to] = GENERATE(
+        std::make_pair("initial: 0", "initial: 3"),
+        std::make_pair("final: 0 1 -1", "final: 0 2 -1"),
+        std::make_pair("behaviour: 0 1 3", "behaviour: 0 1 4"),
+        std::make_pair(" -1 1 0\n", " -1 3 0\n"),
+        std::make_pair(" 0 0 2\n", " 2 0 2\n"),
+        std::make_pair(" 0 0 2\n", " 0 0 5\n"),
+        std::make_pair(" 1 3 0\n", " 1 3 1\n"),
+        std::make_pair("states: 3", "states: 4294967299"),
+        std::make_pair("bdd nodes: 4", "bdd nodes: 99999999999999999999"));
+    auto malformed = content;
+    malformed.replace(malformed.find(from), std::string(from).size(), to);
+    REQUIRE_THROWS_AS(
+        parse_mona_dfa(malformed.data(), malformed.data() + malformed.size()),
+        std::runtime_error);
+  }
+
+  SECTION("Missing file") {
+    REQUIRE_THROWS_AS(parse_mona_dfa_file("this-file-does-not-exist.dfa"),
+                      std::runtime_error);
+  }
+}
+
+} // namespace whitemech::lydia::Test
@@ -22,6 +22,25 @@
 
 namespace whitemech::lydia::Test {
 
+/*
+ * Compare two automata on all the traces up to the given length.
+ */
+static bool same_language(const mona_dfa& a, const mona_dfa& b,
+                          int max_length) {
+  const int n = a.get_nb_variables();
+  for (int length = 0; length <= max_length; length++) {
+    auto nb_traces = 1 << (n * length);
+    for (int t = 0; t < nb_traces; t++) {
+      auto word = trace(length, interpretation(n));
+      for (int bit = 0; bit < n * length; bit++)
+        word[bit / n][bit % n] = (t >> bit) & 1;
+      if (a.accepts(word) != b.accepts(word))
+        return false;
+    }
+  }
+  return true;
+}
+
 TEST_CASE("Test universal project.", "[mona_ext]") {
 
   auto indices = std::vector<int>({0, 1, 2});
@@ -48,4 +67,101 @@ TEST_CASE("Test universal project.", "[mona_ext]") {
   //  dfaUniversalProject();
 }
 
-} // namespace whitemech::lydia::Test
\ No newline at end of file
+TEST_CASE("Test n-ary product.", "[mona_ext]") {
+  auto indices = std::vector<int>({0, 1, 2});
+  auto type = GENERATE(dfaAND, dfaOR);
+
+  DFA* a = dfaNext(0);
+  DFA* not_a = dfaNext(0, false);
+  DFA* b = dfaNext(1);
+  DFA* c = dfaNext(2);
+  DFA* ab = dfa_concatenate(a, b, 3, indices.data());
+  DFA* not_a_c = dfa_concatenate(not_a, c, 3, indices.data());
+  auto operands = std::vector<DFA*>({ab, not_a_c, dfaNext(2, false),
+                                     dfaLDLfTrue(), dfaLDLfFalse()});
+
+  SECTION("Compare with the pairwise product") {
+    for (size_t arity = 1; arity <= operands.size(); arity++) {
+      auto group =
+          std::vector<DFA*>(operands.begin(), operands.begin() + arity);
+      DFA* expected = dfaCopy(group[0]);
+      for (size_t i = 1; i < arity; i++) {
+        DFA* tmp = dfaProduct(expected, group[i], type);
+        dfaFree(expected);
+        expected = dfaMinimize(tmp);
+        dfaFree(tmp);
+      }
+      DFA* tmp = dfa_nary_product(group, type);
+      DFA* actual = dfaMinimize(tmp);
+      dfaFree(tmp);
+      REQUIRE(actual->ns == expected->ns);
+
+      REQUIRE(same_language(mona_dfa(actual, indices.size()),
+                            mona_dfa(expected, indices.size()), 2));
+    }
+  }
+
+  SECTION("Only conjunction and disjunction are supported") {
+    REQUIRE_THROWS_AS(dfa_nary_product(operands, dfaIMPL),
+                      std::invalid_argument);
+  }
+
+  for (auto automaton : operands)
+    dfaFree(automaton);
+  dfaFree(a);
+  dfaFree(not_a);
+  dfaFree(b);
+  dfaFree(c);
+}
+
+TEST_CASE("Test concatenation and closure.", "[mona_ext]") {
+  auto indices = std::vector<int>({0, 1, 2});
+  const int n = indices.size();
+  DFA* a = dfaNext(0);
+  DFA* not_b = dfaNext(1, false);
+  DFA* c = dfaNext(2);
+  DFA* a_or_empty = dfa_accept_empty(a);
+  DFA* a_not_b = dfa_concatenate(a, not_b, n, indices.data());
+  auto operands =
+      std::vector<DFA*>({a, not_b, c, a_or_empty, a_not_b, dfaLDLfTrue(),
+                         dfaLDLfFalse(), only_empty()});
+
+  SECTION("Concatenation") {
+    for (auto lhs : operands) {
+      for (auto rhs : operands) {
+        auto actual = mona_dfa(dfa_concatenate(lhs, rhs, n, indices.data()), n);
+        auto expected = mona_dfa(
+            dfa_concatenate_with_guards(lhs, rhs, n, indices.data()), n);
+        REQUIRE(same_language(actual, expected, 3));
+      }
+    }
+  }
+
+  SECTION("Closure") {
+    for (auto operand : operands) {
+      auto actual = mona_dfa(dfa_closure(operand, n, indices.data()), n);
+      auto expected =
+          mona_dfa(dfa_closure_with_guards(operand, n, indices.data()), n);
+      REQUIRE(same_language(actual, expected, 3));
+    }
+  }
+
+  for (auto automaton : operands)
+    dfaFree(automaton);
+}
+
+TEST_CASE("Test conversion of an abstract DFA.", "[mona_ext]") {
+  // the BDD strategy starts from state 1, state 0 being a sink.
+  auto mgr = CUDD::Cudd();
+  auto strategy = BDDStrategy(mgr);
+  auto automaton = to_dfa_from_formula_string("<a ; b>tt", strategy);
+  REQUIRE(automaton->get_initial_state() != 0);
+
+  auto result = mona_dfa(dfa_from_abstract_dfa(*automaton), 2);
+  REQUIRE(result.get_initial_state() == automaton->get_initial_state());
+  REQUIRE(verify(result, {"01", "10"}, true));
+  REQUIRE(verify(result, {"10", "01"}, false));
+  REQUIRE(verify(result, {}, false));
+}
+
+} // namespace whitemech::lydia::Test
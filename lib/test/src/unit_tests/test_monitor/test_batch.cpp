@@ -0,0 +1,76 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <lydia/dfa/classification.hpp>
+#include <lydia/monitor/batch.hpp>
+#include <random>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("Monitor batch", "[monitor][batch]") {
+  auto formula_string =
+      GENERATE(std::string("<a ; b>tt"), std::string("[true*]<a + b>tt"),
+               std::string("<(a ; b)*>end"), std::string("<true*><a & b>tt"));
+  // not a multiple of the SIMD width, nor of the bitmap words.
+  auto nb_instances = GENERATE(1, 7, 203);
+  auto formula = parse_ldlf(formula_string);
+  auto strategy = CompositionalStrategy();
+  auto automaton = Translator(strategy).to_dfa(*formula);
+  const auto& mona = dynamic_cast<const mona_dfa&>(*automaton);
+  auto compiled = compiled_dfa(mona);
+  auto classification = classify_states(mona);
+
+  auto batch = MonitorBatch(compiled, nb_instances);
+  REQUIRE(batch.size() == (size_t)nb_instances);
+  std::vector<int> expected(nb_instances, automaton->get_initial_state());
+  auto check = [&]() {
+    for (int i = 0; i < nb_instances; i++) {
+      REQUIRE(batch.get_states()[i] == (uint32_t)expected[i]);
+      REQUIRE(batch.is_final(i) == automaton->is_final(expected[i]));
+      REQUIRE(batch.is_sink(i) == !classification.is_live(expected[i]));
+    }
+  };
+  check();
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<uint32_t> random_symbol(0, 3);
+  std::vector<uint32_t> symbols(nb_instances);
+  for (int step = 0; step < 10; step++) {
+    for (int i = 0; i < nb_instances; i++) {
+      symbols[i] = random_symbol(generator);
+      expected[i] = automaton->get_successor(
+          expected[i],
+          interpretation{int(symbols[i] & 1), int(symbols[i] >> 1)});
+    }
+    batch.step(symbols);
+    check();
+    if (step == 5) {
+      batch.reset(0);
+      expected[0] = automaton->get_initial_state();
+      check();
+    }
+  }
+
+  batch.reset();
+  std::fill(expected.begin(), expected.end(), automaton->get_initial_state());
+  check();
+  REQUIRE_THROWS_AS(batch.step(std::vector<uint32_t>(nb_instances + 1)),
+                    std::invalid_argument);
+}
+
+} // namespace whitemech::lydia::Test
@@ -0,0 +1,114 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <lydia/monitor/progression.hpp>
+
+namespace whitemech::lydia::Test {
+
+static bool is_true(MonitorVerdict verdict) {
+  return verdict == MonitorVerdict::permanently_true ||
+         verdict == MonitorVerdict::presumably_true;
+}
+
+TEST_CASE("Progression monitor", "[monitor][progression]") {
+  auto formula_string =
+      GENERATE(std::string("<a ; b>tt"), std::string("[true*]<a + b>tt"),
+               std::string("<(a ; b)*>end"), std::string("<true*><a & b>end"),
+               std::string("[true*](a -> <true*>b)"));
+  auto formula = parse_ldlf(formula_string);
+
+  auto strategy = CompositionalStrategy();
+  auto expected = Translator(strategy).to_dfa(*formula);
+  auto monitor = ProgressionMonitor(*formula);
+  REQUIRE(monitor.get_nb_variables() == 2);
+
+  // the verdict after the trace must agree with the DFA, and a
+  // permanent verdict must agree with every extension of the trace.
+  for (int length = 0; length <= 4; length++) {
+    for (int code = 0; code < (1 << (2 * length)); code++) {
+      trace word;
+      for (int k = 0; k < length; k++)
+        word.push_back({(code >> (2 * k)) & 1, (code >> (2 * k + 1)) & 1});
+      monitor.reset();
+      auto verdict = monitor.run(word);
+      if (is_permanent(verdict)) {
+        for (int extension = 0; extension < 4; extension++) {
+          auto longer = word;
+          longer.push_back({extension & 1, (extension >> 1) & 1});
+          REQUIRE(expected->accepts(longer) == is_true(verdict));
+        }
+      } else {
+        REQUIRE(monitor.get_nb_steps() == word.size());
+      }
+      REQUIRE(expected->accepts(word) == is_true(verdict));
+    }
+  }
+}
+
+TEST_CASE("Progression monitor early termination",
+          "[monitor][progression]") {
+  auto formula = parse_ldlf("<a>tt");
+  auto monitor = ProgressionMonitor(*formula);
+  const auto& a = monitor.get_atoms()[0];
+  REQUIRE(monitor.get_verdict() == MonitorVerdict::presumably_false);
+
+  SECTION("Accepting sink") {
+    REQUIRE(monitor.step(set_atoms_ptr{a}) ==
+            MonitorVerdict::permanently_true);
+    REQUIRE(monitor.step(set_atoms_ptr{}) ==
+            MonitorVerdict::permanently_true);
+    REQUIRE(monitor.get_nb_steps() == 1);
+  }
+
+  SECTION("Rejecting sink") {
+    REQUIRE(monitor.step(set_atoms_ptr{}) ==
+            MonitorVerdict::permanently_false);
+    REQUIRE(monitor.is_permanent());
+    REQUIRE(monitor.step(set_atoms_ptr{a}) ==
+            MonitorVerdict::permanently_false);
+    REQUIRE(monitor.get_nb_steps() == 1);
+  }
+
+  SECTION("Reset") {
+    monitor.step(set_atoms_ptr{});
+    monitor.reset();
+    REQUIRE(monitor.get_verdict() == MonitorVerdict::presumably_false);
+    REQUIRE(monitor.get_nb_steps() == 0);
+    REQUIRE(monitor.step(set_atoms_ptr{a}) ==
+            MonitorVerdict::permanently_true);
+  }
+}
+
+TEST_CASE("Progression monitor on LTLf", "[monitor][progression]") {
+  auto context = std::make_shared<AstManager>();
+  auto driver = parsers::ltlf::LTLfDriver(context);
+  std::stringstream stream("G(a)");
+  driver.parse(stream);
+  auto formula = std::static_pointer_cast<const LTLfFormula>(driver.result);
+  auto monitor = ProgressionMonitor(*formula);
+  REQUIRE(monitor.get_verdict() == MonitorVerdict::presumably_true);
+  REQUIRE(monitor.run({{1}, {1}, {1}}) == MonitorVerdict::presumably_true);
+  REQUIRE(monitor.get_nb_steps() == 3);
+  // the progressions are memoized, so no new formula is met.
+  auto nb_formulas = monitor.get_nb_formulas();
+  REQUIRE(monitor.run({{1}, {1}, {1}}) == MonitorVerdict::presumably_true);
+  REQUIRE(monitor.get_nb_formulas() == nb_formulas);
+  REQUIRE_FALSE(is_true(monitor.step(interpretation{0})));
+}
+
+} // namespace whitemech::lydia::Test
@@ -38,6 +38,22 @@ TEST_CASE("Duality", "[to_dfa][property_tests][duality]") {
   }
 }
 
+TEST_CASE("Naive strategy with Gray-code sweep",
+          "[to_dfa][property_tests][naive]") {
+  auto mgr = CUDD::Cudd();
+  auto strategy_1 = NaiveStrategy(mgr);
+  auto strategy_2 = NaiveStrategy(mgr, 1, true);
+  for (const auto& [i, formula] : iter::enumerate(FORMULAS)) {
+    SECTION(fmt::format("Test Gray-code sweep on formula {} '{}'", i,
+                        formula)) {
+      adfa_ptr automaton_1 = to_dfa_from_formula_string(formula, strategy_1);
+      adfa_ptr automaton_2 = to_dfa_from_formula_string(formula, strategy_2);
+      REQUIRE(compare<3>(*automaton_1, *automaton_2,
+                         automaton_1->get_nb_variables(), equal));
+    }
+  }
+}
+
 TEST_CASE("Simple theorems", "[to_dfa][property_tests][simple_theorems]") {
   auto strategy = CompositionalStrategy();
   for (const auto& theorem : SIMPLE_THEOREMS) {
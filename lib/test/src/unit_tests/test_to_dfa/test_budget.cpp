@@ -0,0 +1,95 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <lydia/to_dfa/budget.hpp>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("Translation budget", "[to_dfa][budget]") {
+  auto formula = parse_ldlf("<a ; b ; c ; d>tt");
+  auto strategy_maker = GENERATE(strategies());
+  auto mgr = CUDD::Cudd();
+  auto strategy = strategy_maker(mgr);
+
+  SECTION("No limits") {
+    TranslationBudget budget;
+    auto translator = Translator(*strategy, &budget);
+    auto automaton = translator.to_dfa(*formula);
+    REQUIRE(verify(*automaton, {"0001", "0010", "0100", "1000"}, true));
+  }
+
+  SECTION("Cancelled") {
+    TranslationBudget budget;
+    budget.cancel();
+    auto translator = Translator(*strategy, &budget);
+    try {
+      translator.to_dfa(*formula);
+      FAIL("The translation should have been cancelled.");
+    } catch (const budget_exceeded_error& e) {
+      REQUIRE(e.violation == BudgetViolation::cancelled);
+    }
+  }
+
+  SECTION("Maximum number of DFA states") {
+    TranslationBudget budget;
+    budget.set_max_dfa_states(3);
+    auto translator = Translator(*strategy, &budget);
+    try {
+      translator.to_dfa(*formula);
+      FAIL("The translation should have exceeded the budget.");
+    } catch (const budget_exceeded_error& e) {
+      REQUIRE(e.violation == BudgetViolation::dfa_states);
+      REQUIRE(e.statistics.max_dfa_states > 3);
+    }
+  }
+}
+
+/*
+ * The intermediate DFAs must be freed wherever the budget is exceeded;
+ * the leaks are reported when the tests are built with -DSANITIZE=ON.
+ */
+TEST_CASE("Translation budget with stars", "[to_dfa][budget]") {
+  auto formula_string = GENERATE(
+      std::string("<(a ; b)*><c>tt"), std::string("[(a + b)*]<c>tt"),
+      std::string("<(<a>tt? ; b)*>end"), std::string("[(<c>tt? ; a)*]ff"),
+      std::string("<((a ; b)* ; <c>tt?)*>end"));
+  auto formula = parse_ldlf(formula_string);
+  auto strategy = CompositionalStrategy();
+
+  SECTION("Cancelled") {
+    TranslationBudget budget;
+    budget.cancel();
+    auto translator = Translator(strategy, &budget);
+    REQUIRE_THROWS_AS(translator.to_dfa(*formula), budget_exceeded_error);
+  }
+
+  SECTION("Maximum number of DFA states") {
+    for (size_t max_states = 1; max_states <= 8; max_states++) {
+      TranslationBudget budget;
+      budget.set_max_dfa_states(max_states);
+      auto translator = Translator(strategy, &budget);
+      try {
+        translator.to_dfa(*formula);
+      } catch (const budget_exceeded_error& e) {
+        REQUIRE(e.violation == BudgetViolation::dfa_states);
+      }
+    }
+  }
+}
+
+} // namespace whitemech::lydia::Test
@@ -0,0 +1,139 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <lydia/to_dfa/cache.hpp>
+#include <lydia/to_dfa/strategies/bdd/base.hpp>
+#include <lydia/to_dfa/strategies/compositional/base.hpp>
+#include <unistd.h>
+
+namespace whitemech::lydia::Test {
+
+static std::string cache_directory() {
+  auto path = std::filesystem::temp_directory_path() /
+              ("lydia-test-cache-" + std::to_string(getpid()));
+  std::filesystem::remove_all(path);
+  return path.string();
+}
+
+TEST_CASE("Translation cache keys", "[to_dfa][cache]") {
+  auto strategy = CompositionalStrategy();
+  auto key = TranslationCache::make_key(*parse_ldlf("!(<a>tt)"),
+                                        strategy);
+  // the formulas are parsed in different contexts.
+  REQUIRE(key == TranslationCache::make_key(*parse_ldlf("[a]ff"),
+                                            strategy));
+  REQUIRE(key != TranslationCache::make_key(*parse_ldlf("[b]ff"),
+                                            strategy));
+
+  strategy.atom_ordering = std::make_shared<ForceOrdering>();
+  REQUIRE(key != TranslationCache::make_key(*parse_ldlf("[a]ff"),
+                                            strategy));
+}
+
+TEST_CASE("Translation cache", "[to_dfa][cache]") {
+  auto directory = cache_directory();
+  auto formula_1 = parse_ldlf("<a ; b ; c>tt & [true*]<a + b>tt");
+  auto formula_2 = parse_ldlf("<(a ; b)*>end & !(<true*><c>tt)");
+  auto strategy = CompositionalStrategy();
+  auto expected_1 = Translator(strategy).to_dfa(*formula_1);
+  auto expected_2 = Translator(strategy).to_dfa(*formula_2);
+
+  SECTION("Warm runs hit the cache") {
+    auto cache = TranslationCache(directory);
+    auto translator = Translator(strategy, nullptr, &cache);
+    auto miss = translator.to_dfa(*formula_1);
+    auto hit = translator.to_dfa(*formula_1);
+    REQUIRE(compare<3>(*hit, *expected_1, 3));
+    REQUIRE(hit->get_nb_states() == expected_1->get_nb_states());
+
+    // a new cache on the same directory, as in a new run.
+    auto other_cache = TranslationCache(directory);
+    auto other_strategy = CompositionalStrategy();
+    auto other_hit = Translator(other_strategy, nullptr, &other_cache)
+                         .to_dfa(*parse_ldlf(formula_1->str()));
+    REQUIRE(compare<3>(*other_hit, *expected_1, 3));
+
+    REQUIRE(cache.get_statistics().nb_hits == 1);
+    REQUIRE(cache.get_statistics().nb_misses == 1);
+    REQUIRE(cache.get_statistics().nb_stores == 1);
+    REQUIRE(cache.get_statistics().hit_rate() == 0.5);
+    REQUIRE(other_cache.get_statistics().nb_hits == 1);
+  }
+
+  SECTION("The symbolic DFAs are loaded as symbolic DFAs") {
+    auto cache = TranslationCache(directory);
+    auto mgr = CUDD::Cudd();
+    auto bdd_strategy = BDDStrategy(mgr);
+    auto translator = Translator(bdd_strategy, nullptr, &cache);
+    translator.to_dfa(*formula_2);
+    auto hit = translator.to_dfa(*formula_2);
+    REQUIRE(cache.get_statistics().nb_hits == 1);
+    REQUIRE(std::dynamic_pointer_cast<dfa>(hit) != nullptr);
+    REQUIRE(compare<3>(*hit, *expected_2, 3));
+  }
+
+  SECTION("The least recently used entries are evicted") {
+    auto cache = TranslationCache(directory);
+    auto translator = Translator(strategy, nullptr, &cache);
+    translator.to_dfa(*formula_1);
+    auto size = cache.get_size();
+    REQUIRE(size > 0);
+    for (const auto& entry : std::filesystem::directory_iterator(directory))
+      std::filesystem::last_write_time(
+          entry.path(), entry.last_write_time() - std::chrono::hours(1));
+
+    auto small_cache = TranslationCache(directory, size);
+    auto small_translator = Translator(strategy, nullptr, &small_cache);
+    small_translator.to_dfa(*formula_2);
+    REQUIRE(small_cache.get_statistics().nb_evictions >= 1);
+    REQUIRE(small_cache.get_size() <= size);
+    small_translator.to_dfa(*formula_1);
+    REQUIRE(small_cache.get_statistics().nb_hits == 0);
+  }
+
+  SECTION("Corrupted entries are discarded") {
+    auto cache = TranslationCache(directory);
+    auto translator = Translator(strategy, nullptr, &cache);
+    translator.to_dfa(*formula_1);
+    for (const auto& entry : std::filesystem::directory_iterator(directory))
+      std::ofstream(entry.path(), std::ios::binary) << "garbage";
+    auto result = translator.to_dfa(*formula_1);
+    REQUIRE(compare<3>(*result, *expected_1, 3));
+    REQUIRE(cache.get_statistics().nb_invalid == 1);
+    REQUIRE(cache.get_statistics().nb_hits == 0);
+  }
+
+  SECTION("Failed stores do not lose the translation") {
+    auto cache = TranslationCache(directory);
+    auto translator = Translator(strategy, nullptr, &cache);
+    // the entries can no longer be written.
+    std::filesystem::remove_all(directory);
+    auto result = translator.to_dfa(*formula_1);
+    REQUIRE(compare<3>(*result, *expected_1, 3));
+    REQUIRE(cache.get_statistics().nb_failed_stores == 1);
+    REQUIRE(cache.get_statistics().nb_stores == 0);
+    REQUIRE(!std::filesystem::exists(directory));
+  }
+
+  std::filesystem::remove_all(directory);
+}
+
+} // namespace whitemech::lydia::Test
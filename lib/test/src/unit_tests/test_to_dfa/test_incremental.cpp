@@ -0,0 +1,71 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <lydia/to_dfa/strategies/compositional/incremental.hpp>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("Incremental translation", "[to_dfa][compositional][incremental]") {
+  // the atoms appear out of order, to force the remapping of the indices.
+  auto operands = std::vector<std::string>{
+      "<true*><c>tt", "<a ; true>tt", "[true*](<b>tt | [true]ff)"};
+  auto strategy = CompositionalStrategy();
+
+  SECTION("Conjunction") {
+    auto translator = IncrementalTranslator(strategy);
+    for (const auto& operand : operands)
+      translator.conjoin(*parse_ldlf(operand));
+    auto expected_strategy = CompositionalStrategy();
+    auto expected = Translator(expected_strategy)
+                        .to_dfa(*parse_ldlf("(" + operands[0] +
+                                                    ") & (" + operands[1] +
+                                                    ") & (" + operands[2] +
+                                                    ")"));
+    auto actual = translator.get_dfa();
+    REQUIRE(actual->names == std::vector<std::string>({"a", "b", "c"}));
+    REQUIRE(actual->get_nb_states() == expected->get_nb_states());
+    REQUIRE(compare<3>(*actual, *expected, 3));
+  }
+
+  SECTION("Disjunction") {
+    auto translator = IncrementalTranslator(strategy, false);
+    for (const auto& operand : operands)
+      translator.disjoin(*parse_ldlf(operand));
+    auto expected_strategy = CompositionalStrategy();
+    auto expected = Translator(expected_strategy)
+                        .to_dfa(*parse_ldlf("(" + operands[0] +
+                                                    ") | (" + operands[1] +
+                                                    ") | (" + operands[2] +
+                                                    ")"));
+    auto actual = translator.get_dfa();
+    REQUIRE(actual->get_nb_states() == expected->get_nb_states());
+    REQUIRE(compare<3>(*actual, *expected, 3));
+  }
+
+  SECTION("Dominant sink") {
+    auto translator = IncrementalTranslator(strategy);
+    translator.conjoin(*parse_ldlf("ff"));
+    translator.conjoin(*parse_ldlf(operands[0]));
+    REQUIRE(translator.get_nb_states() == 1);
+    REQUIRE(translator.get_atoms().size() == 1);
+    translator.reset();
+    REQUIRE(translator.get_atoms().empty());
+  }
+}
+
+} // namespace whitemech::lydia::Test
@@ -0,0 +1,54 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <lydia/to_dfa/lazy.hpp>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("Lazy DFA", "[to_dfa][lazy]") {
+  auto formula_string =
+      GENERATE(std::string("<a ; b>tt"), std::string("[true*]<a + b>tt"),
+               std::string("<(a ; b)*>end"), std::string("<true*><a & b>end"));
+  auto max_cached_states = GENERATE(1, 1024);
+  auto formula = parse_ldlf(formula_string);
+
+  auto strategy = CompositionalStrategy();
+  auto expected = Translator(strategy).to_dfa(*formula);
+  auto lazy = LazyDFA(*formula, max_cached_states);
+  REQUIRE(lazy.get_nb_variables() == 2);
+
+  // all the traces up to length 4, twice: the second time, the
+  // transitions are memoized (if the cache is large enough).
+  for (int round = 0; round < 2; round++) {
+    for (int length = 0; length <= 4; length++) {
+      for (int code = 0; code < (1 << (2 * length)); code++) {
+        trace word;
+        for (int k = 0; k < length; k++)
+          word.push_back({(code >> (2 * k)) & 1, (code >> (2 * k + 1)) & 1});
+        REQUIRE(lazy.accepts(word) == expected->accepts(word));
+      }
+    }
+  }
+  REQUIRE(lazy.get_nb_cached_states() <= (size_t)max_cached_states);
+  if (max_cached_states > 1) {
+    REQUIRE(lazy.get_statistics().nb_hits > 0);
+    REQUIRE(lazy.get_statistics().nb_evictions == 0);
+  }
+}
+
+} // namespace whitemech::lydia::Test
@@ -0,0 +1,58 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <lydia/to_dfa/strategies/compositional/base.hpp>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("Minimization policy", "[to_dfa][compositional][minimization]") {
+  auto formula_string = GENERATE(
+      std::string("<a ; b ; c>tt & <true*><c>tt & [true*](<a>tt | <b>tt)"),
+      std::string("<(a ; b)*>end | <(c ; c)*>end"),
+      std::string("!(<true ; true>tt) & <(a + b)*><c>end"));
+  auto mode = GENERATE(MinimizationMode::always,
+                       MinimizationMode::size_threshold,
+                       MinimizationMode::ratio, MinimizationMode::final_only);
+  auto formula = parse_ldlf(formula_string);
+
+  auto expected_strategy = CompositionalStrategy();
+  auto expected = Translator(expected_strategy).to_dfa(*formula);
+
+  auto strategy = CompositionalStrategy();
+  strategy.minimization.mode = mode;
+  strategy.minimization.size_threshold = 2;
+  auto actual = Translator(strategy).to_dfa(*formula);
+  const auto& statistics = strategy.minimization.get_statistics();
+
+  // minimal DFAs are unique up to isomorphism.
+  REQUIRE(actual->get_nb_states() == expected->get_nb_states());
+  REQUIRE(compare<3>(*actual, *expected, 3, equal));
+  REQUIRE(statistics.nb_requests ==
+          statistics.nb_minimizations + statistics.nb_skipped);
+  if (mode == MinimizationMode::always) {
+    REQUIRE(statistics.nb_skipped == 0);
+  }
+  if (mode == MinimizationMode::final_only) {
+    REQUIRE(statistics.nb_minimizations == 1);
+  }
+
+  strategy.minimization.reset_statistics();
+  REQUIRE(strategy.minimization.get_statistics().nb_requests == 0);
+}
+
+} // namespace whitemech::lydia::Test
@@ -0,0 +1,78 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <lydia/logic/atom_ordering.hpp>
+#include <lydia/to_dfa/budget.hpp>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("Portfolio translation", "[to_dfa][portfolio]") {
+  auto mgr = CUDD::Cudd();
+  auto strategy = StrategyGenerator::make_portfolio(mgr);
+  auto& portfolio = dynamic_cast<PortfolioStrategy&>(*strategy);
+
+  auto automaton = to_dfa_from_formula_string("<a ; b>tt", *strategy);
+  REQUIRE(dynamic_cast<const mona_dfa*>(automaton.get()) != nullptr);
+  REQUIRE((portfolio.get_winner() == "bdd" ||
+           portfolio.get_winner() == "compositional"));
+  REQUIRE(verify(*automaton, {"01", "10"}, true));
+  REQUIRE(verify(*automaton, {"10", "01"}, false));
+  REQUIRE(verify(*automaton, {"01"}, false));
+}
+
+TEST_CASE("Portfolio variable names", "[to_dfa][portfolio]") {
+  auto mgr = CUDD::Cudd();
+  auto bdd = std::make_shared<BDDStrategy>(mgr);
+  bdd->atom_ordering = std::make_shared<InterleavedOrdering>(
+      std::vector<std::vector<std::string>>({{"z"}}));
+  auto strategy = PortfolioStrategy({{"bdd", bdd}});
+
+  auto automaton = std::dynamic_pointer_cast<mona_dfa>(
+      to_dfa_from_formula_string("<a ; z>tt", strategy));
+  REQUIRE(automaton != nullptr);
+  REQUIRE(automaton->names == std::vector<std::string>({"z", "a"}));
+  REQUIRE(verify(*automaton, {"10", "01"}, true));
+  REQUIRE(verify(*automaton, {"01", "10"}, false));
+}
+
+TEST_CASE("Nested portfolio", "[to_dfa][portfolio]") {
+  auto mgr = CUDD::Cudd();
+  auto strategy = PortfolioStrategy({
+      {"inner", StrategyGenerator::make_portfolio(mgr)},
+      {"compositional", StrategyGenerator::make_compositional(mgr)},
+  });
+  auto automaton = to_dfa_from_formula_string("<a ; b>tt", strategy);
+  REQUIRE(verify(*automaton, {"01", "10"}, true));
+  REQUIRE(verify(*automaton, {"10", "01"}, false));
+}
+
+TEST_CASE("Portfolio budget", "[to_dfa][portfolio][budget]") {
+  auto mgr = CUDD::Cudd();
+  auto strategy = StrategyGenerator::make_portfolio(mgr);
+  TranslationBudget budget;
+  budget.cancel();
+  auto translator = Translator(*strategy, &budget);
+  auto formula = parse_ldlf("<a ; b>tt");
+  REQUIRE_THROWS_AS(translator.to_dfa(*formula), budget_exceeded_error);
+}
+
+TEST_CASE("Empty portfolio", "[to_dfa][portfolio]") {
+  REQUIRE_THROWS_AS(PortfolioStrategy({}), std::invalid_argument);
+}
+
+} // namespace whitemech::lydia::Test
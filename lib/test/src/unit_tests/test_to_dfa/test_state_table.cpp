@@ -0,0 +1,66 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <catch.hpp>
+#include <lydia/logic/ldlf/base.hpp>
+#include <lydia/to_dfa/state_table.hpp>
+
+namespace whitemech::lydia::Test {
+
+TEST_CASE("State table", "[to_dfa][state_table]") {
+  auto context = AstManager{};
+  auto tt = context.makeLdlfTrue();
+  auto ff = context.makeLdlfFalse();
+  auto nfa_tt = std::make_shared<NFAState>(context, set_formulas{tt});
+  auto nfa_ff = std::make_shared<NFAState>(context, set_formulas{ff});
+  auto nfa_tt_ff = std::make_shared<NFAState>(context, set_formulas{tt, ff});
+
+  auto state_1 = DFAState(context, set_nfa_states{nfa_tt});
+  auto state_2 = DFAState(context, set_nfa_states{nfa_tt, nfa_ff});
+  auto state_3 = DFAState(context, set_nfa_states{nfa_tt_ff});
+  auto empty = DFAState(context, set_nfa_states{});
+
+  // small capacity, to trigger rehashing.
+  StateTable table(2);
+  REQUIRE(table.find(state_1) == -1);
+  REQUIRE(table.insert(state_1, 1) == std::make_pair(1, true));
+  REQUIRE(table.insert(state_2, 2) == std::make_pair(2, true));
+  REQUIRE(table.insert(state_3, 3) == std::make_pair(3, true));
+  REQUIRE(table.insert(empty, 4) == std::make_pair(4, true));
+  REQUIRE(table.size() == 4);
+  REQUIRE(table.nb_nfa_states() == 3);
+
+  SECTION("Equal states are found, regardless of the pointers") {
+    auto other_tt = std::make_shared<NFAState>(context, set_formulas{tt});
+    auto other_ff = std::make_shared<NFAState>(context, set_formulas{ff});
+    auto other_state_2 = DFAState(context, set_nfa_states{other_ff, other_tt});
+    REQUIRE(table.find(other_state_2) == 2);
+    REQUIRE(table.insert(other_state_2, 42) == std::make_pair(2, false));
+    REQUIRE(table.find(DFAState(context, set_nfa_states{})) == 4);
+    REQUIRE(table.size() == 4);
+    REQUIRE(table.nb_nfa_states() == 3);
+  }
+
+  SECTION("Unknown states are not found") {
+    auto nfa_empty = std::make_shared<NFAState>(context, set_formulas{});
+    REQUIRE(table.find(DFAState(context, set_nfa_states{nfa_ff})) == -1);
+    REQUIRE(table.find(DFAState(context, set_nfa_states{nfa_empty})) == -1);
+    REQUIRE(table.intern(nfa_ff) == table.intern(nfa_ff));
+    REQUIRE(table.nb_nfa_states() == 3);
+  }
+}
+
+} // namespace whitemech::lydia::Test
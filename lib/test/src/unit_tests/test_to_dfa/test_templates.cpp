@@ -0,0 +1,66 @@
+/*
+ * This file is part of Lydia.
+ *
+ * Lydia is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Lydia is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Lydia.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "test/src/utils/to_dfa.hpp"
+#include <catch.hpp>
+#include <lydia/logic/atom_visitor.hpp>
+#include <lydia/to_dfa/strategies/compositional/base.hpp>
+
+namespace whitemech::lydia::Test {
+
+static std::string response(const std::string& req,
+                            const std::string& grant) {
+  return "[true*]([" + req + "]ff | <true*><" + grant + ">tt)";
+}
+
+TEST_CASE("Formula templates", "[to_dfa][compositional][templates]") {
+  auto formula = parse_ldlf(response("a", "b") + " & " +
+                                    response("c", "d") + " & " +
+                                    response("f", "e"));
+  std::map<atom_ptr, size_t, SharedComparator> atom2ids;
+  for (const auto& atom : find_atoms(*formula))
+    atom2ids.emplace(atom, atom2ids.size());
+
+  auto t_ab = make_template(*parse_ldlf(response("a", "b")), atom2ids);
+  auto t_cd = make_template(*parse_ldlf(response("c", "d")), atom2ids);
+  auto t_fe = make_template(*parse_ldlf(response("f", "e")), atom2ids);
+  REQUIRE(t_ab.key == t_cd.key);
+  REQUIRE(t_ab.atom_ids == std::vector<int>({0, 1}));
+  REQUIRE(t_cd.atom_ids == std::vector<int>({2, 3}));
+  // the renaming would not preserve the order of the identifiers.
+  REQUIRE(t_ab.key != t_fe.key);
+  REQUIRE(t_fe.atom_ids == std::vector<int>({4, 5}));
+}
+
+TEST_CASE("Template reuse", "[to_dfa][compositional][templates]") {
+  auto formula = parse_ldlf(response("a", "b") + " & " +
+                                    response("c", "d") + " & " +
+                                    response("e", "f"));
+
+  auto expected_strategy = CompositionalStrategy();
+  expected_strategy.use_templates = false;
+  auto expected = Translator(expected_strategy).to_dfa(*formula);
+  REQUIRE(expected_strategy.templates.size() == 0);
+
+  auto strategy = CompositionalStrategy();
+  auto actual = Translator(strategy).to_dfa(*formula);
+  REQUIRE(actual->get_nb_states() == expected->get_nb_states());
+  REQUIRE(compare<2>(*actual, *expected, 6));
+  // the last two conjuncts are instances of the first one.
+  REQUIRE(strategy.templates.get_statistics().nb_hits >= 2);
+}
+
+} // namespace whitemech::lydia::Test
@@ -35,6 +35,7 @@
 #include <lydia/to_dfa/strategies/bdd/base.hpp>
 #include <lydia/to_dfa/strategies/compositional/base.hpp>
 #include <lydia/to_dfa/strategies/naive.hpp>
+#include <lydia/to_dfa/strategies/portfolio.hpp>
 
 namespace whitemech::lydia {
 
@@ -134,6 +135,13 @@ from_trace_set(std::vector<interpretation_set> vector, int prop) {
   return result;
 }
 
+static ldlf_ptr parse_ldlf(const std::string& formula) {
+  auto driver = parsers::ldlf::Driver();
+  std::stringstream stream(formula);
+  driver.parse(stream);
+  return std::static_pointer_cast<const LDLfFormula>(driver.result);
+}
+
 static adfa_ptr to_dfa_from_formula_string(const std::string& f, Strategy& s) {
   auto driver = parsers::ldlf::Driver();
   std::stringstream ldlf_formula_stream(f);
@@ -179,10 +187,17 @@ public:
     return std::make_shared<CompositionalStrategy>();
   }
   static std::shared_ptr<Strategy> make_bdd(const CUDD::Cudd& mgr) {
-    return std::make_shared<BDDStrategy>(mgr, 20);
+    return std::make_shared<BDDStrategy>(mgr);
   }
   static std::shared_ptr<Strategy> make_naive(const CUDD::Cudd& mgr) {
-    return std::make_shared<NaiveStrategy>(CUDD::Cudd(), 20);
+    return std::make_shared<NaiveStrategy>(mgr);
+  }
+  static std::shared_ptr<Strategy> make_portfolio(const CUDD::Cudd& mgr) {
+    return std::make_shared<PortfolioStrategy>(
+        std::vector<std::pair<std::string, std::shared_ptr<Strategy>>>{
+            {"bdd", make_bdd(mgr)},
+            {"compositional", make_compositional(mgr)},
+        });
   }
 };
 Catch::Generators::GeneratorWrapper<